@@ -0,0 +1,213 @@
+/**@file bench.hpp
+ *
+ * Micro-benchmark harness of uboost benchmark suite. Every benchmark runs
+ * a fixed number of operations several times and keeps the fastest run,
+ * reported as nanoseconds per operation. On linux, retired instructions
+ * and cache misses are also sampled through perf_event_open(2) when the
+ * kernel allows it, otherwise they are reported as null.
+ */
+
+#ifndef UBOOST_BENCH_HPP_
+#define UBOOST_BENCH_HPP_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define UBOOST_BENCH_PERF
+#endif
+
+namespace bench
+{
+
+// keep value alive so the compiler can not drop the benchmarked code
+template <typename T>
+inline void do_not_optimize(T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+inline void clobber()
+{
+    asm volatile("" : : : "memory");
+}
+
+struct result
+{
+    const char* suite;
+    const char* name;
+    const char* impl;
+    uint32_t ops;
+    double ns_per_op;
+    // valid only if counters is true
+    bool counters;
+    double instructions_per_op;
+    double cache_misses_per_op;
+};
+
+class perf_counters
+{
+    public:
+    perf_counters()
+    :_instr(-1),_miss(-1)
+    {
+#ifdef UBOOST_BENCH_PERF
+        _instr=open(PERF_COUNT_HW_INSTRUCTIONS, -1);
+        if(_instr>=0)
+            _miss=open(PERF_COUNT_HW_CACHE_MISSES, _instr);
+        if(_miss<0 && _instr>=0)
+        {
+            close(_instr);
+            _instr=-1;
+        }
+#endif
+    };
+
+    ~perf_counters()
+    {
+#ifdef UBOOST_BENCH_PERF
+        if(_miss>=0)close(_miss);
+        if(_instr>=0)close(_instr);
+#endif
+    };
+
+    bool available() const
+    {
+        return _instr>=0;
+    };
+
+    void start()
+    {
+#ifdef UBOOST_BENCH_PERF
+        if(!available())return;
+        ioctl(_instr, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(_instr, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    };
+
+    // return false if counters could not be read
+    bool stop(uint64_t& instructions, uint64_t& cache_misses)
+    {
+#ifdef UBOOST_BENCH_PERF
+        if(!available())return false;
+        ioctl(_instr, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // PERF_FORMAT_GROUP layout: nr, values[nr]
+        uint64_t data[3];
+        if(read(_instr, data, sizeof(data))!=(ssize_t)sizeof(data) || data[0]!=2)
+            return false;
+        instructions=data[1];
+        cache_misses=data[2];
+        return true;
+#else
+        (void)instructions;
+        (void)cache_misses;
+        return false;
+#endif
+    };
+
+    private:
+#ifdef UBOOST_BENCH_PERF
+    static int open(uint64_t config, int group)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type=PERF_TYPE_HARDWARE;
+        attr.size=sizeof(attr);
+        attr.config=config;
+        attr.disabled=(group<0);
+        attr.exclude_kernel=1;
+        attr.exclude_hv=1;
+        attr.read_format=PERF_FORMAT_GROUP;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+    };
+#endif
+
+    int _instr;
+    int _miss;
+};
+
+inline uint64_t now_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000ull+ts.tv_nsec;
+}
+
+class runner
+{
+    public:
+    static const int repeat=7;
+
+    runner()
+    :_count(0){};
+
+    /**
+     *  @brief run body(ops) repeat times(plus one warm up run) and record
+     *  the fastest run
+     *  @param ops number of operations performed by one call of body
+     */
+    template <typename Body>
+    void run(const char* suite, const char* name, const char* impl,
+             uint32_t ops, Body body)
+    {
+        result r={suite, name, impl, ops, 0, false, 0, 0};
+        uint64_t best=~0ull;
+        body(ops);
+        for(int i=0;i<repeat;i++)
+        {
+            uint64_t instructions=0, cache_misses=0;
+            _perf.start();
+            uint64_t t0=now_ns();
+            body(ops);
+            uint64_t t1=now_ns();
+            bool counted=_perf.stop(instructions, cache_misses);
+            if(t1-t0<best)
+            {
+                best=t1-t0;
+                r.counters=counted;
+                r.instructions_per_op=(double)instructions/ops;
+                r.cache_misses_per_op=(double)cache_misses/ops;
+            }
+        }
+        r.ns_per_op=(double)best/ops;
+        if(_count<max_results)
+            _results[_count++]=r;
+    };
+
+    // write all results as a JSON document
+    void report(FILE* out) const
+    {
+        fprintf(out, "{\n  \"perf_counters\": %s,\n  \"benchmarks\": [\n",
+                _perf.available()?"true":"false");
+        for(int i=0;i<_count;i++)
+        {
+            const result& r=_results[i];
+            fprintf(out, "    {\"suite\": \"%s\", \"name\": \"%s\", \"impl\": \"%s\", "
+                         "\"ops\": %u, \"ns_per_op\": %.3f, ",
+                    r.suite, r.name, r.impl, r.ops, r.ns_per_op);
+            if(r.counters)
+                fprintf(out, "\"instructions_per_op\": %.2f, \"cache_misses_per_op\": %.4f}",
+                        r.instructions_per_op, r.cache_misses_per_op);
+            else
+                fprintf(out, "\"instructions_per_op\": null, \"cache_misses_per_op\": null}");
+            fprintf(out, "%s\n", (i+1<_count)?",":"");
+        }
+        fprintf(out, "  ]\n}\n");
+    };
+
+    private:
+    static const int max_results=256;
+    perf_counters _perf;
+    result _results[max_results];
+    int _count;
+};
+
+};//namespace bench
+
+#endif /* UBOOST_BENCH_HPP_ */
@@ -0,0 +1,86 @@
+#include <iostream>
+#include <functional>
+
+#include "../../include/uboost.hpp"
+#include "bench.hpp"
+
+namespace
+{
+
+struct adder
+{
+    int a;
+    int b;
+    int operator()(int x) const
+    {
+        return a*x+b;
+    };
+};
+
+template <typename Function>
+void function_suite(bench::runner& r, const char* impl)
+{
+    const uint32_t ops=1000000;
+    adder f={3, 7};
+
+    r.run("function", "construct", impl, ops, [&](uint32_t n)
+    {
+        for(uint32_t i=0;i<n;i++)
+        {
+            Function fn(f);
+            bench::do_not_optimize(fn);
+        }
+    });
+
+    Function src(f);
+    r.run("function", "copy", impl, ops, [&](uint32_t n)
+    {
+        for(uint32_t i=0;i<n;i++)
+        {
+            Function fn(src);
+            bench::do_not_optimize(fn);
+        }
+    });
+
+    r.run("function", "move", impl, ops, [&](uint32_t n)
+    {
+        // one move per op, target alternates between a and b
+        Function a(f), b(f);
+        for(uint32_t i=0;i<n;i++)
+        {
+            Function& to=(i&1)?a:b;
+            to=std::move((i&1)?b:a);
+            bench::do_not_optimize(to);
+        }
+    });
+
+    r.run("function", "invoke", impl, ops, [&](uint32_t n)
+    {
+        Function fn(f);
+        bench::do_not_optimize(fn);
+        int acc=0;
+        for(uint32_t i=0;i<n;i++)
+            acc+=fn(i);
+        bench::do_not_optimize(acc);
+    });
+}
+
+};
+
+void function_bench_main(bench::runner& r)
+{
+    function_suite<std::function<int(int)> >(r, "std");
+    function_suite<uboost::function<int(int)> >(r, "uboost");
+
+    const uint32_t ops=1000000;
+    adder f={3, 7};
+    r.run("function", "invoke", "uboost_ref", ops, [&](uint32_t n)
+    {
+        uboost::function_ref<int(int)> fn(f);
+        bench::do_not_optimize(fn);
+        int acc=0;
+        for(uint32_t i=0;i<n;i++)
+            acc+=fn(i);
+        bench::do_not_optimize(acc);
+    });
+}
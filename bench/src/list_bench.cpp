@@ -0,0 +1,176 @@
+#include <iostream>
+#include <list>
+
+#include "../../include/uboost.hpp"
+#include "../../include/list.hpp"
+#include "bench.hpp"
+
+namespace
+{
+
+const uboost::size_type elements=4000;
+const uint32_t rounds=100;
+
+struct std_lists
+{
+    typedef std::list<uint32_t> list_type;
+
+    list_type a;
+    list_type b;
+};
+
+struct uboost_lists
+{
+    typedef uboost::list<uint32_t> list_type;
+
+    uboost_lists()
+    :a(pool),b(pool){};
+
+    uboost::declare::listpool<uint32_t, elements+1> pool;
+    list_type a;
+    list_type b;
+};
+
+// 256 byte record, only its links are used while walking
+struct record
+{
+    record(uint32_t _id):id(_id){};
+    uint32_t id;
+    uint8_t body[252];
+};
+
+template <typename Layout>
+struct record_lists
+{
+    typedef uboost::declare::listpool<record, elements+1, uboost::size_type,
+                                      alignof(record), Layout> pool_type;
+    typedef typename pool_type::list_type list_type;
+
+    record_lists()
+    :a(pool),b(pool){};
+
+    pool_type pool;
+    list_type a;
+    list_type b;
+};
+
+// link chasing over large records: positioning by index and moving a
+// range between lists(which counts it)
+template <typename Lists>
+void record_suite(bench::runner& r, const char* impl)
+{
+    Lists* l=new Lists;
+    typename Lists::list_type& a=l->a;
+    typename Lists::list_type& b=l->b;
+
+    for(uint32_t i=0;i<elements;i++)
+        a.emplace_back(i);
+
+    r.run("list", "record_walk", impl, rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            auto it=a.cbegin()+(elements-1);
+            bench::do_not_optimize(it);
+        }
+    });
+
+    r.run("list", "record_splice_range", impl, rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k+=2)
+        {
+            b.splice(b.cend(), a, a.cbegin(), a.cend());
+            a.splice(a.cend(), b, b.cbegin(), b.cend());
+        }
+        bench::do_not_optimize(a);
+    });
+
+    delete l;
+}
+
+template <typename Lists>
+void list_suite(bench::runner& r, const char* impl)
+{
+    Lists* l=new Lists;
+    typename Lists::list_type& a=l->a;
+    typename Lists::list_type& b=l->b;
+
+    r.run("list", "emplace_back", impl, rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            a.clear();
+            for(uint32_t i=0;i<elements;i++)
+                a.emplace_back(i);
+            bench::do_not_optimize(a);
+        }
+    });
+
+    r.run("list", "emplace_front", impl, rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            a.clear();
+            for(uint32_t i=0;i<elements;i++)
+                a.emplace_front(i);
+            bench::do_not_optimize(a);
+        }
+    });
+
+    // erase every other element while walking the list
+    r.run("list", "erase", impl, rounds*elements/2, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/(elements/2);k++)
+        {
+            a.clear();
+            for(uint32_t i=0;i<elements;i++)
+                a.emplace_back(i);
+            auto it=a.begin();
+            for(uint32_t i=0;i<elements/2;i++)
+            {
+                it=a.erase(it);
+                ++it;
+            }
+            bench::do_not_optimize(a);
+        }
+    });
+
+    a.clear();
+    for(uint32_t i=0;i<elements;i++)
+        a.emplace_back(i);
+
+    // move single node between lists and back
+    r.run("list", "splice", impl, rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t i=0;i<n;i+=2)
+        {
+            b.splice(b.begin(), a, a.begin());
+            a.splice(a.end(), b, b.begin());
+        }
+        bench::do_not_optimize(a);
+    });
+
+    r.run("list", "iterate", impl, rounds*elements, [&](uint32_t n)
+    {
+        uint32_t acc=0;
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            auto end=a.end();
+            for(auto it=a.begin();it!=end;++it)
+                acc+=*it;
+        }
+        bench::do_not_optimize(acc);
+    });
+
+    delete l;
+}
+
+};
+
+void list_bench_main(bench::runner& r)
+{
+    list_suite<std_lists>(r, "std");
+    list_suite<uboost_lists>(r, "uboost");
+    record_suite<record_lists<uboost::interleaved_layout> >(r, "uboost");
+    record_suite<record_lists<uboost::split_layout> >(r, "uboost_split");
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "../../include/algorithm/simd.hpp"
+#include "bench.hpp"
+
+namespace
+{
+
+const uboost::size_type elements=4096;
+const uint32_t rounds=1000;
+
+// plain loops as written without the kernels, kept out of
+// auto-vectorization of float reductions like a -O2 build does
+float scalar_sum(const float* p, const float* last)
+{
+    float s=0;
+    for(;p!=last;p++)
+        s+=*p;
+    return s;
+}
+
+float scalar_dot(const float* p, const float* last, const float* b)
+{
+    float s=0;
+    for(;p!=last;p++,b++)
+        s+=*p**b;
+    return s;
+}
+
+};
+
+void simd_bench_main(bench::runner& r)
+{
+    static uboost::declare::vector<float, elements, uboost::size_type, 32> a, b;
+    a.clear();
+    b.clear();
+    for(uint32_t i=0;i<elements;i++)
+    {
+        a.push_back(float(i%17));
+        b.push_back(0.5f);
+    }
+
+    r.run("simd", "sum", "scalar", rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            float s=scalar_sum(a.data(), a.data()+a.size());
+            bench::do_not_optimize(s);
+        }
+    });
+
+    r.run("simd", "sum", "uboost", rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            float s=uboost::simd::sum(a);
+            bench::do_not_optimize(s);
+        }
+    });
+
+    r.run("simd", "dot", "scalar", rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            float s=scalar_dot(a.data(), a.data()+a.size(), b.data());
+            bench::do_not_optimize(s);
+        }
+    });
+
+    r.run("simd", "dot", "uboost", rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            float s=uboost::simd::dot(a, b);
+            bench::do_not_optimize(s);
+        }
+    });
+
+    r.run("simd", "count", "uboost", rounds*elements, [&](uint32_t n)
+    {
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            uboost::size_type c=uboost::simd::count(a, 3);
+            bench::do_not_optimize(c);
+        }
+    });
+}
@@ -0,0 +1,37 @@
+#include <iostream>
+#include <string.h>
+
+#include "bench.hpp"
+
+void function_bench_main(bench::runner& r);
+void vector_bench_main(bench::runner& r);
+void list_bench_main(bench::runner& r);
+void simd_bench_main(bench::runner& r);
+
+static bool selected(int argc, char** argv, const char* suite)
+{
+    if(argc<2)
+        return true;
+    for(int i=1;i<argc;i++)
+        if(!strcmp(argv[i], suite))
+            return true;
+    return false;
+}
+
+// usage: uboost_bench [function] [vector] [list] [simd], runs all suites by default
+int main(int argc, char** argv)
+{
+    static bench::runner r;
+
+    if(selected(argc, argv, "function"))
+        function_bench_main(r);
+    if(selected(argc, argv, "vector"))
+        vector_bench_main(r);
+    if(selected(argc, argv, "list"))
+        list_bench_main(r);
+    if(selected(argc, argv, "simd"))
+        simd_bench_main(r);
+
+    r.report(stdout);
+    return 0;
+};
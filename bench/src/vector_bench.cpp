@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "bench.hpp"
+
+namespace
+{
+
+const uboost::size_type elements=4000;
+
+struct point
+{
+    point(){};
+    point(int _x, int _y)
+    :x(_x),y(_y){};
+
+    int x;
+    int y;
+};
+
+// std::vector is reserved up front so both sides run without reallocation
+template <typename T>
+void prepare(std::vector<T>& v)
+{
+    v.reserve(elements);
+}
+
+template <typename T>
+void prepare(uboost::vector<T>&)
+{
+}
+
+template <typename Vector, typename PointVector>
+void vector_suite(bench::runner& r, const char* impl)
+{
+    const uint32_t rounds=200;
+
+    r.run("vector", "push_back", impl, rounds*elements, [&](uint32_t n)
+    {
+        Vector v;
+        prepare(v);
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            v.clear();
+            for(uint32_t i=0;i<elements;i++)
+                v.push_back(i);
+            bench::do_not_optimize(v);
+        }
+    });
+
+    r.run("vector", "emplace_back", impl, rounds*elements, [&](uint32_t n)
+    {
+        PointVector v;
+        prepare(v);
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            v.clear();
+            for(uint32_t i=0;i<elements;i++)
+                v.emplace_back(i, i+1);
+            bench::do_not_optimize(v);
+        }
+    });
+
+    // insert in the middle, vector grows from elements/2 to elements
+    const uint32_t half=elements/2;
+    r.run("vector", "insert_middle", impl, rounds*half, [&](uint32_t n)
+    {
+        Vector v;
+        prepare(v);
+        for(uint32_t k=0;k<n/half;k++)
+        {
+            v.assign(half, 1);
+            for(uint32_t i=0;i<half;i++)
+                v.insert(v.begin()+v.size()/2, i);
+            bench::do_not_optimize(v);
+        }
+    });
+
+    r.run("vector", "erase_middle", impl, rounds*half, [&](uint32_t n)
+    {
+        Vector v;
+        prepare(v);
+        for(uint32_t k=0;k<n/half;k++)
+        {
+            v.assign(elements, 1);
+            for(uint32_t i=0;i<half;i++)
+                v.erase(v.begin()+v.size()/2);
+            bench::do_not_optimize(v);
+        }
+    });
+
+    Vector src;
+    prepare(src);
+    for(uint32_t i=0;i<elements;i++)
+        src.push_back(i);
+    r.run("vector", "assign_range", impl, rounds*elements, [&](uint32_t n)
+    {
+        Vector v;
+        prepare(v);
+        for(uint32_t k=0;k<n/elements;k++)
+        {
+            v.assign(src.cbegin(), src.cend());
+            bench::do_not_optimize(v);
+            v.clear();
+        }
+    });
+}
+
+};
+
+void vector_bench_main(bench::runner& r)
+{
+    vector_suite<std::vector<uint32_t>, std::vector<point> >(r, "std");
+    vector_suite<uboost::declare::vector<uint32_t, elements>,
+                 uboost::declare::vector<point, elements> >(r, "uboost");
+}
@@ -0,0 +1,264 @@
+/**@file expression.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * Element-wise arithmetic(+, -, *, /) over uboost::vector as lazy
+ * expression objects. `out = a * k + b - c` builds a small tree of
+ * operands and is evaluated by vector assignment in one fused loop,
+ * without any temporary vector. Operands keep pointer to vector data, so
+ * expression should be assigned before its vectors go out of scope.
+ *
+ * When every vector in an expression is a uboost::declare::vector,
+ * destination capacity is checked at compile time: it should be at least
+ * the smallest operand capacity. Operand sizes are checked at runtime by
+ * assert.
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 16:20:12 2026 okyfirmansyah
+ */
+
+#include "../config.hpp"
+
+#ifndef UBOOST_ALGORITHM_EXPRESSION_HPP_
+#define UBOOST_ALGORITHM_EXPRESSION_HPP_
+
+#include "../uboost.hpp"
+#include "../vector.hpp"
+
+namespace uboost
+{
+
+/**
+ *  @brief vector leaf of an expression
+ *  @tparam T element type
+ *  @tparam Capacity capacity of declared vector, 0 if it is not known
+ */
+template <class T, uint64_t Capacity>
+class vector_operand
+{
+	public:
+	typedef T value_type;
+	static const bool scalar=false;
+	static const uint64_t capacity=Capacity;
+
+	vector_operand(const T* __data, uint64_t __sz)
+	:_data(__data),_sz(__sz){};
+
+	T operator[](uint64_t i) const
+	{
+		return _data[i];
+	};
+
+	uint64_t size() const
+	{
+		return _sz;
+	};
+
+	private:
+	const T* _data;
+	uint64_t _sz;
+};
+
+/**
+ *  @brief scalar leaf of an expression, same value for every element
+ */
+template <class T>
+class scalar_operand
+{
+	public:
+	typedef T value_type;
+	static const bool scalar=true;
+	static const uint64_t capacity=0;
+
+	explicit scalar_operand(const T& __val)
+	:_val(__val){};
+
+	T operator[](uint64_t) const
+	{
+		return _val;
+	};
+
+	uint64_t size() const
+	{
+		return 0;
+	};
+
+	private:
+	T _val;
+};
+
+namespace _internal
+{
+
+struct expr_add{template <class T> static T apply(T a, T b){return a+b;}};
+struct expr_sub{template <class T> static T apply(T a, T b){return a-b;}};
+struct expr_mul{template <class T> static T apply(T a, T b){return a*b;}};
+struct expr_div{template <class T> static T apply(T a, T b){return a/b;}};
+
+// operands have same size at runtime, so the smaller known capacity
+// bounds the result
+template <uint64_t L, uint64_t R>
+struct expr_capacity
+{
+	static const uint64_t value=(L==0)?R:(R==0)?L:(L<R)?L:R;
+};
+
+};//namespace _internal
+
+/**
+ *  @brief element-wise binary operation node
+ *  @tparam Op operation(_internal::expr_add, ...)
+ *  @tparam L left operand node
+ *  @tparam R right operand node
+ */
+template <class Op, class L, class R>
+class vector_expression
+{
+	public:
+	typedef typename L::value_type value_type;
+	static const bool scalar=false;
+	// marks type assignable to uboost::vector
+	static const bool vector_expression_tag=true;
+	static const uint64_t capacity=_internal::expr_capacity<L::capacity, R::capacity>::value;
+
+	vector_expression(const L& __l, const R& __r)
+	:_l(__l),_r(__r),_sz(L::scalar?__r.size():__l.size())
+	{
+		UBOOST_ASSERT(L::scalar || R::scalar || __l.size()==__r.size());
+	};
+
+	value_type operator[](uint64_t i) const
+	{
+		return Op::apply(_l[i], _r[i]);
+	};
+
+	uint64_t size() const
+	{
+		return _sz;
+	};
+
+	private:
+	L _l;
+	R _r;
+	uint64_t _sz;
+};
+
+namespace _internal
+{
+
+// maps vector or expression to its expression node
+template <class X>
+struct expr_operand
+{
+	static const bool value=false;
+};
+
+template <class T, class S>
+struct expr_operand<uboost::vector<T, S> >
+{
+	static const bool value=true;
+	typedef T value_type;
+	typedef vector_operand<T, 0> type;
+	static type make(const uboost::vector<T, S>& v){return type(v.data(), v.size());};
+};
+
+template <class T, uint64_t Size, class S, size_type Align>
+struct expr_operand<declare::vector<T, Size, S, Align> >
+{
+	static const bool value=true;
+	typedef T value_type;
+	typedef vector_operand<T, Size> type;
+	static type make(const declare::vector<T, Size, S, Align>& v){return type(v.data(), v.size());};
+};
+
+template <class Op, class L, class R>
+struct expr_operand<vector_expression<Op, L, R> >
+{
+	static const bool value=true;
+	typedef typename L::value_type value_type;
+	typedef vector_expression<Op, L, R> type;
+	static const type& make(const type& e){return e;};
+};
+
+// result of vector op vector
+template <class Op, class L, class R,
+          bool enabled=expr_operand<L>::value && expr_operand<R>::value>
+struct expr_result
+{
+};
+
+template <class Op, class L, class R>
+struct expr_result<Op, L, R, true>
+{
+	typedef vector_expression<Op, typename expr_operand<L>::type,
+	                              typename expr_operand<R>::type> type;
+	static type make(const L& l, const R& r)
+	{
+		return type(expr_operand<L>::make(l), expr_operand<R>::make(r));
+	};
+};
+
+// result of vector op scalar
+template <class Op, class L, bool enabled=expr_operand<L>::value>
+struct expr_scalar_result
+{
+};
+
+template <class Op, class L>
+struct expr_scalar_result<Op, L, true>
+{
+	typedef typename expr_operand<L>::value_type value_type;
+	typedef scalar_operand<value_type> scalar_type;
+	typedef vector_expression<Op, typename expr_operand<L>::type, scalar_type> right_type;
+	typedef vector_expression<Op, scalar_type, typename expr_operand<L>::type> left_type;
+
+	static right_type make(const L& l, const value_type& k)
+	{
+		return right_type(expr_operand<L>::make(l), scalar_type(k));
+	};
+
+	static left_type make(const value_type& k, const L& r)
+	{
+		return left_type(scalar_type(k), expr_operand<L>::make(r));
+	};
+};
+
+};//namespace _internal
+
+#define UBOOST_VECTOR_EXPRESSION_OPERATOR(op, Op)                                    \
+template <class L, class R>                                                          \
+typename _internal::expr_result<Op, L, R>::type operator op(const L& l, const R& r)  \
+{                                                                                    \
+	return _internal::expr_result<Op, L, R>::make(l, r);                             \
+}                                                                                    \
+                                                                                     \
+template <class L>                                                                   \
+typename _internal::expr_scalar_result<Op, L>::right_type                            \
+operator op(const L& l, const typename _internal::expr_operand<L>::value_type& k)    \
+{                                                                                    \
+	return _internal::expr_scalar_result<Op, L>::make(l, k);                         \
+}                                                                                    \
+                                                                                     \
+template <class R>                                                                   \
+typename _internal::expr_scalar_result<Op, R>::left_type                             \
+operator op(const typename _internal::expr_operand<R>::value_type& k, const R& r)    \
+{                                                                                    \
+	return _internal::expr_scalar_result<Op, R>::make(k, r);                         \
+}
+
+UBOOST_VECTOR_EXPRESSION_OPERATOR(+, _internal::expr_add)
+UBOOST_VECTOR_EXPRESSION_OPERATOR(-, _internal::expr_sub)
+UBOOST_VECTOR_EXPRESSION_OPERATOR(*, _internal::expr_mul)
+UBOOST_VECTOR_EXPRESSION_OPERATOR(/, _internal::expr_div)
+
+#undef UBOOST_VECTOR_EXPRESSION_OPERATOR
+
+};//namespace uboost
+
+#endif /* UBOOST_ALGORITHM_EXPRESSION_HPP_ */
@@ -0,0 +1,116 @@
+/**@file parallel.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * Parallel sweep over every live item of a uboost::listpool. Item array is
+ * split in contiguous slices(whole occupancy bitmap words), each slice is
+ * visited in array order by its own thread. Only available on POSIX
+ * targets(pthreads), other targets can split the pool by
+ * listpool::for_each_range() on their own workers.
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 21:05:44 2026 okyfirmansyah
+ */
+
+#include "../config.hpp"
+
+#ifndef UBOOST_ALGORITHM_PARALLEL_HPP_
+#define UBOOST_ALGORITHM_PARALLEL_HPP_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <pthread.h>
+
+#include "../uboost.hpp"
+#include "../list.hpp"
+
+namespace uboost
+{
+
+/**
+ *  @brief maximum number of threads used by parallel_for_each()
+ */
+const unsigned max_parallel_workers=16;
+
+namespace _internal
+{
+
+template <class T, class Idx, class Layout, class F>
+struct pool_slice
+{
+	listpool<T, Idx, Layout>* pool;
+	Idx first;
+	Idx last;
+	F* f;
+};
+
+template <class T, class Idx, class Layout, class F>
+void* run_pool_slice(void* arg)
+{
+	pool_slice<T, Idx, Layout, F>* s=static_cast<pool_slice<T, Idx, Layout, F>*>(arg);
+	s->pool->for_each_range(s->first, s->last, *s->f);
+	return nullptr;
+};
+
+};//namespace _internal
+
+/**
+ *  @brief call f(item content) for every claimed item of pool using up to
+ *  workers threads(calling thread included). Every thread gets its own
+ *  slice of item array, so f is never called concurrently on the same item
+ *  but it should be safe to call concurrently on different items. Pool
+ *  should not be modified until it returns. Slice whose thread can not be
+ *  created is visited by calling thread
+ */
+template <class T, class Idx, class Layout, class F>
+void parallel_for_each(listpool<T, Idx, Layout>& pool, F f, unsigned workers)
+{
+	typedef _internal::pool_slice<T, Idx, Layout, F> slice_type;
+	const size_type bits=_internal::bitmap_word_bits;
+
+	if(workers>max_parallel_workers)
+		workers=max_parallel_workers;
+	if(!workers)
+		workers=1;
+	uint64_t words=(uint64_t(pool.max_size())+bits-1)/bits;
+	uint64_t perWorker=(words+workers-1)/workers;
+	if(!perWorker)
+		perWorker=1;
+
+	slice_type slices[max_parallel_workers];
+	pthread_t threads[max_parallel_workers];
+	bool started[max_parallel_workers];
+	unsigned n=0;
+	for(uint64_t w=0;w<words && n<workers;w+=perWorker,n++)
+	{
+		uint64_t last=(w+perWorker)*bits;
+		slices[n].pool=&pool;
+		slices[n].first=Idx(w*bits);
+		slices[n].last=Idx(last<pool.max_size()?last:pool.max_size());
+		slices[n].f=&f;
+		started[n]=false;
+	}
+
+	// first slice is visited by calling thread
+	for(unsigned i=1;i<n;i++)
+		started[i]=(pthread_create(&threads[i], nullptr,
+		                           &_internal::run_pool_slice<T, Idx, Layout, F>, &slices[i])==0);
+	for(unsigned i=0;i<n;i++)
+		if(!started[i])
+			_internal::run_pool_slice<T, Idx, Layout, F>(&slices[i]);
+	for(unsigned i=1;i<n;i++)
+		if(started[i])
+			pthread_join(threads[i], nullptr);
+};
+
+};//namespace uboost
+
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+#endif /* UBOOST_ALGORITHM_PARALLEL_HPP_ */
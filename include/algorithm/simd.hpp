@@ -0,0 +1,807 @@
+/**@file simd.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * Numeric kernels over contiguous arithmetic data(raw pointer range or
+ * uboost::vector). float, double, int32_t, uint32_t, int16_t and uint8_t
+ * run on SSE2 or AVX2 vectors, selected at compile time from compiler
+ * target macros(__SSE2__, __AVX2__, so build with -mavx2 or -march=native
+ * to get AVX2 kernels); any other type(int8_t, uint16_t, 64-bit integers),
+ * or target without SIMD, runs the scalar fallback.
+ *
+ * min(), max() and clamp() treat NaN like the scalar loop does: a NaN
+ * element is skipped by min()/max() unless it is the first one, and is
+ * left as is by clamp().
+ *
+ * Floating point sum() and dot() add lanes in a different order than a
+ * plain loop, so their result may differ in the last bits.
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 15:02:31 2026 okyfirmansyah
+ */
+
+#include "../config.hpp"
+
+#ifndef UBOOST_ALGORITHM_SIMD_HPP_
+#define UBOOST_ALGORITHM_SIMD_HPP_
+
+#include "../uboost.hpp"
+#include "../vector.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UBOOST_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#include <emmintrin.h>
+#define UBOOST_SIMD_SSE2
+#endif
+
+namespace uboost
+{
+
+namespace simd
+{
+
+/**
+ *  @brief comparison used by compare_mask()
+ */
+enum compare_op
+{
+	compare_eq,
+	compare_lt,
+	compare_gt,
+};
+
+namespace _internal
+{
+
+/**
+ *  @brief SIMD register abstraction of type T, kernels are written once
+ *  against it. Types without specialization are not vectorized
+ */
+template <class T>
+struct batch
+{
+	static const bool enabled=false;
+};
+
+#if defined(UBOOST_SIMD_AVX2)
+
+template <>
+struct batch<float>
+{
+	static const bool enabled=true;
+	static const int width=8;
+	typedef __m256 type;
+
+	static type load(const float* p){return _mm256_loadu_ps(p);};
+	static void store(float* p, type a){_mm256_storeu_ps(p, a);};
+	static type set1(float v){return _mm256_set1_ps(v);};
+	static type add(type a, type b){return _mm256_add_ps(a, b);};
+	static type mul(type a, type b){return _mm256_mul_ps(a, b);};
+	static type min(type a, type b){return _mm256_min_ps(a, b);};
+	static type max(type a, type b){return _mm256_max_ps(a, b);};
+	static uint32_t eq(type a, type b){return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));};
+	static uint32_t lt(type a, type b){return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ));};
+	static uint32_t gt(type a, type b){return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ));};
+};
+
+template <>
+struct batch<double>
+{
+	static const bool enabled=true;
+	static const int width=4;
+	typedef __m256d type;
+
+	static type load(const double* p){return _mm256_loadu_pd(p);};
+	static void store(double* p, type a){_mm256_storeu_pd(p, a);};
+	static type set1(double v){return _mm256_set1_pd(v);};
+	static type add(type a, type b){return _mm256_add_pd(a, b);};
+	static type mul(type a, type b){return _mm256_mul_pd(a, b);};
+	static type min(type a, type b){return _mm256_min_pd(a, b);};
+	static type max(type a, type b){return _mm256_max_pd(a, b);};
+	static uint32_t eq(type a, type b){return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));};
+	static uint32_t lt(type a, type b){return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ));};
+	static uint32_t gt(type a, type b){return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ));};
+};
+
+template <>
+struct batch<int32_t>
+{
+	static const bool enabled=true;
+	static const int width=8;
+	typedef __m256i type;
+
+	static type load(const int32_t* p){return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));};
+	static void store(int32_t* p, type a){_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);};
+	static type set1(int32_t v){return _mm256_set1_epi32(v);};
+	static type add(type a, type b){return _mm256_add_epi32(a, b);};
+	static type mul(type a, type b){return _mm256_mullo_epi32(a, b);};
+	static type min(type a, type b){return _mm256_min_epi32(a, b);};
+	static type max(type a, type b){return _mm256_max_epi32(a, b);};
+	static uint32_t mask(type a){return _mm256_movemask_ps(_mm256_castsi256_ps(a));};
+	static uint32_t eq(type a, type b){return mask(_mm256_cmpeq_epi32(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm256_cmpgt_epi32(b, a));};
+	static uint32_t gt(type a, type b){return mask(_mm256_cmpgt_epi32(a, b));};
+};
+
+template <>
+struct batch<uint32_t>
+{
+	static const bool enabled=true;
+	static const int width=8;
+	typedef __m256i type;
+
+	static type load(const uint32_t* p){return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));};
+	static void store(uint32_t* p, type a){_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);};
+	static type set1(uint32_t v){return _mm256_set1_epi32(int32_t(v));};
+	static type add(type a, type b){return _mm256_add_epi32(a, b);};
+	static type mul(type a, type b){return _mm256_mullo_epi32(a, b);};
+	static type min(type a, type b){return _mm256_min_epu32(a, b);};
+	static type max(type a, type b){return _mm256_max_epu32(a, b);};
+	// unsigned order from signed compare with flipped sign bits
+	static type flip(type a){return _mm256_xor_si256(a, _mm256_set1_epi32(int32_t(0x80000000u)));};
+	static uint32_t mask(type a){return _mm256_movemask_ps(_mm256_castsi256_ps(a));};
+	static uint32_t eq(type a, type b){return mask(_mm256_cmpeq_epi32(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm256_cmpgt_epi32(flip(b), flip(a)));};
+	static uint32_t gt(type a, type b){return mask(_mm256_cmpgt_epi32(flip(a), flip(b)));};
+};
+
+template <>
+struct batch<int16_t>
+{
+	static const bool enabled=true;
+	static const int width=16;
+	typedef __m256i type;
+
+	static type load(const int16_t* p){return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));};
+	static void store(int16_t* p, type a){_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);};
+	static type set1(int16_t v){return _mm256_set1_epi16(v);};
+	static type add(type a, type b){return _mm256_add_epi16(a, b);};
+	static type mul(type a, type b){return _mm256_mullo_epi16(a, b);};
+	static type min(type a, type b){return _mm256_min_epi16(a, b);};
+	static type max(type a, type b){return _mm256_max_epi16(a, b);};
+	static uint32_t mask(type a)
+	{
+		// pack lanes to bytes, pack works per 128-bit half so the two
+		// halves land at bits 0-7 and 16-23
+		uint32_t m=_mm256_movemask_epi8(_mm256_packs_epi16(a, _mm256_setzero_si256()));
+		return (m&0xFFu)|((m>>8)&0xFF00u);
+	};
+	static uint32_t eq(type a, type b){return mask(_mm256_cmpeq_epi16(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm256_cmpgt_epi16(b, a));};
+	static uint32_t gt(type a, type b){return mask(_mm256_cmpgt_epi16(a, b));};
+};
+
+template <>
+struct batch<uint8_t>
+{
+	static const bool enabled=true;
+	static const int width=32;
+	typedef __m256i type;
+
+	static type load(const uint8_t* p){return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));};
+	static void store(uint8_t* p, type a){_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);};
+	static type set1(uint8_t v){return _mm256_set1_epi8(char(v));};
+	static type add(type a, type b){return _mm256_add_epi8(a, b);};
+	static type mul(type a, type b)
+	{
+		// no 8-bit multiply, multiply even and odd bytes as 16-bit lanes
+		__m256i even=_mm256_mullo_epi16(a, b);
+		__m256i odd=_mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+		return _mm256_or_si256(_mm256_and_si256(even, _mm256_set1_epi16(0xFF)), _mm256_slli_epi16(odd, 8));
+	};
+	static type min(type a, type b){return _mm256_min_epu8(a, b);};
+	static type max(type a, type b){return _mm256_max_epu8(a, b);};
+	static type flip(type a){return _mm256_xor_si256(a, _mm256_set1_epi8(char(0x80)));};
+	static uint32_t mask(type a){return uint32_t(_mm256_movemask_epi8(a));};
+	static uint32_t eq(type a, type b){return mask(_mm256_cmpeq_epi8(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm256_cmpgt_epi8(flip(b), flip(a)));};
+	static uint32_t gt(type a, type b){return mask(_mm256_cmpgt_epi8(flip(a), flip(b)));};
+};
+
+#elif defined(UBOOST_SIMD_SSE2)
+
+template <>
+struct batch<float>
+{
+	static const bool enabled=true;
+	static const int width=4;
+	typedef __m128 type;
+
+	static type load(const float* p){return _mm_loadu_ps(p);};
+	static void store(float* p, type a){_mm_storeu_ps(p, a);};
+	static type set1(float v){return _mm_set1_ps(v);};
+	static type add(type a, type b){return _mm_add_ps(a, b);};
+	static type mul(type a, type b){return _mm_mul_ps(a, b);};
+	static type min(type a, type b){return _mm_min_ps(a, b);};
+	static type max(type a, type b){return _mm_max_ps(a, b);};
+	static uint32_t eq(type a, type b){return _mm_movemask_ps(_mm_cmpeq_ps(a, b));};
+	static uint32_t lt(type a, type b){return _mm_movemask_ps(_mm_cmplt_ps(a, b));};
+	static uint32_t gt(type a, type b){return _mm_movemask_ps(_mm_cmpgt_ps(a, b));};
+};
+
+template <>
+struct batch<double>
+{
+	static const bool enabled=true;
+	static const int width=2;
+	typedef __m128d type;
+
+	static type load(const double* p){return _mm_loadu_pd(p);};
+	static void store(double* p, type a){_mm_storeu_pd(p, a);};
+	static type set1(double v){return _mm_set1_pd(v);};
+	static type add(type a, type b){return _mm_add_pd(a, b);};
+	static type mul(type a, type b){return _mm_mul_pd(a, b);};
+	static type min(type a, type b){return _mm_min_pd(a, b);};
+	static type max(type a, type b){return _mm_max_pd(a, b);};
+	static uint32_t eq(type a, type b){return _mm_movemask_pd(_mm_cmpeq_pd(a, b));};
+	static uint32_t lt(type a, type b){return _mm_movemask_pd(_mm_cmplt_pd(a, b));};
+	static uint32_t gt(type a, type b){return _mm_movemask_pd(_mm_cmpgt_pd(a, b));};
+};
+
+// SSE2 lacks 32-bit min/max/mullo(SSE4.1), they are emulated
+template <>
+struct batch<int32_t>
+{
+	static const bool enabled=true;
+	static const int width=4;
+	typedef __m128i type;
+
+	static type load(const int32_t* p){return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));};
+	static void store(int32_t* p, type a){_mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);};
+	static type set1(int32_t v){return _mm_set1_epi32(v);};
+	static type add(type a, type b){return _mm_add_epi32(a, b);};
+	static type mul(type a, type b)
+	{
+		// multiply even and odd lanes separately, keep low halves
+		__m128i even=_mm_mul_epu32(a, b);
+		__m128i odd=_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)),
+		                          _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+	};
+	static type select(type m, type a, type b)
+	{
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	};
+	static type min(type a, type b){return select(_mm_cmplt_epi32(a, b), a, b);};
+	static type max(type a, type b){return select(_mm_cmpgt_epi32(a, b), a, b);};
+	static uint32_t mask(type a){return _mm_movemask_ps(_mm_castsi128_ps(a));};
+	static uint32_t eq(type a, type b){return mask(_mm_cmpeq_epi32(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm_cmplt_epi32(a, b));};
+	static uint32_t gt(type a, type b){return mask(_mm_cmpgt_epi32(a, b));};
+};
+
+template <>
+struct batch<uint32_t>
+{
+	static const bool enabled=true;
+	static const int width=4;
+	typedef __m128i type;
+	typedef batch<int32_t> S;
+
+	static type load(const uint32_t* p){return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));};
+	static void store(uint32_t* p, type a){_mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);};
+	static type set1(uint32_t v){return _mm_set1_epi32(int32_t(v));};
+	static type add(type a, type b){return _mm_add_epi32(a, b);};
+	// low half of the product is the same for signed and unsigned
+	static type mul(type a, type b){return S::mul(a, b);};
+	// unsigned order from signed compare with flipped sign bits
+	static type flip(type a){return _mm_xor_si128(a, _mm_set1_epi32(int32_t(0x80000000u)));};
+	static type min(type a, type b){return S::select(_mm_cmplt_epi32(flip(a), flip(b)), a, b);};
+	static type max(type a, type b){return S::select(_mm_cmpgt_epi32(flip(a), flip(b)), a, b);};
+	static uint32_t eq(type a, type b){return S::mask(_mm_cmpeq_epi32(a, b));};
+	static uint32_t lt(type a, type b){return S::mask(_mm_cmplt_epi32(flip(a), flip(b)));};
+	static uint32_t gt(type a, type b){return S::mask(_mm_cmpgt_epi32(flip(a), flip(b)));};
+};
+
+template <>
+struct batch<int16_t>
+{
+	static const bool enabled=true;
+	static const int width=8;
+	typedef __m128i type;
+
+	static type load(const int16_t* p){return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));};
+	static void store(int16_t* p, type a){_mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);};
+	static type set1(int16_t v){return _mm_set1_epi16(v);};
+	static type add(type a, type b){return _mm_add_epi16(a, b);};
+	static type mul(type a, type b){return _mm_mullo_epi16(a, b);};
+	static type min(type a, type b){return _mm_min_epi16(a, b);};
+	static type max(type a, type b){return _mm_max_epi16(a, b);};
+	// pack lanes to bytes, one mask bit per lane
+	static uint32_t mask(type a){return uint32_t(_mm_movemask_epi8(_mm_packs_epi16(a, _mm_setzero_si128())));};
+	static uint32_t eq(type a, type b){return mask(_mm_cmpeq_epi16(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm_cmplt_epi16(a, b));};
+	static uint32_t gt(type a, type b){return mask(_mm_cmpgt_epi16(a, b));};
+};
+
+template <>
+struct batch<uint8_t>
+{
+	static const bool enabled=true;
+	static const int width=16;
+	typedef __m128i type;
+
+	static type load(const uint8_t* p){return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));};
+	static void store(uint8_t* p, type a){_mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);};
+	static type set1(uint8_t v){return _mm_set1_epi8(char(v));};
+	static type add(type a, type b){return _mm_add_epi8(a, b);};
+	static type mul(type a, type b)
+	{
+		// no 8-bit multiply, multiply even and odd bytes as 16-bit lanes
+		__m128i even=_mm_mullo_epi16(a, b);
+		__m128i odd=_mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+		return _mm_or_si128(_mm_and_si128(even, _mm_set1_epi16(0xFF)), _mm_slli_epi16(odd, 8));
+	};
+	static type min(type a, type b){return _mm_min_epu8(a, b);};
+	static type max(type a, type b){return _mm_max_epu8(a, b);};
+	static type flip(type a){return _mm_xor_si128(a, _mm_set1_epi8(char(0x80)));};
+	static uint32_t mask(type a){return uint32_t(_mm_movemask_epi8(a));};
+	static uint32_t eq(type a, type b){return mask(_mm_cmpeq_epi8(a, b));};
+	static uint32_t lt(type a, type b){return mask(_mm_cmplt_epi8(flip(a), flip(b)));};
+	static uint32_t gt(type a, type b){return mask(_mm_cmpgt_epi8(flip(a), flip(b)));};
+};
+
+#endif
+
+// keeps value arguments out of template deduction, so find(v, 0) works
+// on vector<float>
+template <class T>
+struct value_of
+{
+	typedef T type;
+};
+
+inline uint32_t lowest_bit(uint32_t m)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(m);
+#else
+	uint32_t i=0;
+	while(!(m&1)){m>>=1;i++;}
+	return i;
+#endif
+}
+
+inline uint32_t bit_count(uint32_t m)
+{
+#if defined(__GNUC__) && defined(__POPCNT__)
+	return __builtin_popcount(m);
+#else
+	// without popcnt instruction builtin is a library call
+	m=m-((m>>1)&0x55555555u);
+	m=(m&0x33333333u)+((m>>2)&0x33333333u);
+	return (((m+(m>>4))&0x0F0F0F0Fu)*0x01010101u)>>24;
+#endif
+}
+
+template <class T>
+inline bool compare(T a, T b, compare_op op)
+{
+	return (op==compare_eq)?(a==b):(op==compare_lt)?(a<b):(a>b);
+}
+
+/**
+ *  @brief kernel implementations, scalar version for types without
+ *  SIMD batch. Every function handles arbitrary length(including zero)
+ */
+template <class T, bool vectorized=batch<T>::enabled>
+struct kernel
+{
+	static const T* find(const T* first, const T* last, T value)
+	{
+		for(;first!=last;first++)
+			if(*first==value)break;
+		return first;
+	};
+
+	static size_type count(const T* first, const T* last, T value)
+	{
+		size_type n=0;
+		for(;first!=last;first++)
+			n+=(*first==value);
+		return n;
+	};
+
+	// first is not empty
+	static T min(const T* first, const T* last)
+	{
+		T m=*first;
+		while(++first!=last)
+			if(*first<m)m=*first;
+		return m;
+	};
+
+	static T max(const T* first, const T* last)
+	{
+		T m=*first;
+		while(++first!=last)
+			if(m<*first)m=*first;
+		return m;
+	};
+
+	static T sum(const T* first, const T* last)
+	{
+		T s=T();
+		for(;first!=last;first++)
+			s+=*first;
+		return s;
+	};
+
+	static T dot(const T* first, const T* last, const T* b)
+	{
+		T s=T();
+		for(;first!=last;first++,b++)
+			s+=*first**b;
+		return s;
+	};
+
+	static void scale_add(const T* first, const T* last, T k, const T* b, T* out)
+	{
+		for(;first!=last;first++,b++,out++)
+			*out=*first*k+*b;
+	};
+
+	static void clamp(T* first, T* last, T lo, T hi)
+	{
+		for(;first!=last;first++)
+			*first=(*first<lo)?lo:(hi<*first)?hi:*first;
+	};
+
+	static void compare_mask(const T* first, const T* last, T value, compare_op op, uint32_t* mask)
+	{
+		uint32_t word=0;
+		uint32_t bit=0;
+		for(;first!=last;first++)
+		{
+			word|=uint32_t(compare(*first, value, op))<<bit;
+			if(++bit==32)
+			{
+				*mask++=word;
+				word=0;
+				bit=0;
+			}
+		}
+		if(bit)
+			*mask=word;
+	};
+};
+
+template <class T>
+struct kernel<T, true>
+{
+	typedef batch<T> B;
+	typedef typename B::type type;
+	typedef kernel<T, false> scalar;
+	static const int W=B::width;
+
+	// end of the part which can be processed in whole batches
+	static const T* batch_end(const T* first, const T* last)
+	{
+		return first+(last-first)/W*W;
+	};
+
+	static const T* find(const T* first, const T* last, T value)
+	{
+		type v=B::set1(value);
+		for(const T* end=batch_end(first, last);first!=end;first+=W)
+		{
+			uint32_t m=B::eq(B::load(first), v);
+			if(m)
+				return first+lowest_bit(m);
+		}
+		return scalar::find(first, last, value);
+	};
+
+	static size_type count(const T* first, const T* last, T value)
+	{
+		type v=B::set1(value);
+		size_type n=0;
+		for(const T* end=batch_end(first, last);first!=end;first+=W)
+			n+=bit_count(B::eq(B::load(first), v));
+		return n+scalar::count(first, last, value);
+	};
+
+	static T reduce_min(type a)
+	{
+		T lanes[W];
+		B::store(lanes, a);
+		return scalar::min(lanes, lanes+W);
+	};
+
+	static T reduce_max(type a)
+	{
+		T lanes[W];
+		B::store(lanes, a);
+		return scalar::max(lanes, lanes+W);
+	};
+
+	static T reduce_sum(type a)
+	{
+		T lanes[W];
+		B::store(lanes, a);
+		return scalar::sum(lanes, lanes+W);
+	};
+
+	static T min(const T* first, const T* last)
+	{
+		if(last-first<W)
+			return scalar::min(first, last);
+		// every lane starts from *first and the loaded value goes first,
+		// min/max return the second operand on NaN, so NaN is skipped
+		// unless *first is NaN, as in the scalar loop
+		type m=B::set1(*first);
+		const T* end=batch_end(first, last);
+		for(;first!=end;first+=W)
+			m=B::min(B::load(first), m);
+		T r=reduce_min(m);
+		for(;first!=last;first++)
+			if(*first<r)r=*first;
+		return r;
+	};
+
+	static T max(const T* first, const T* last)
+	{
+		if(last-first<W)
+			return scalar::max(first, last);
+		type m=B::set1(*first);
+		const T* end=batch_end(first, last);
+		for(;first!=end;first+=W)
+			m=B::max(B::load(first), m);
+		T r=reduce_max(m);
+		for(;first!=last;first++)
+			if(r<*first)r=*first;
+		return r;
+	};
+
+	static T sum(const T* first, const T* last)
+	{
+		// two accumulators hide add latency
+		type s0=B::set1(T()), s1=B::set1(T());
+		const T* end=first+(last-first)/(2*W)*(2*W);
+		for(;first!=end;first+=2*W)
+		{
+			s0=B::add(s0, B::load(first));
+			s1=B::add(s1, B::load(first+W));
+		}
+		end=batch_end(first, last);
+		for(;first!=end;first+=W)
+			s0=B::add(s0, B::load(first));
+		return reduce_sum(B::add(s0, s1))+scalar::sum(first, last);
+	};
+
+	static T dot(const T* first, const T* last, const T* b)
+	{
+		type s0=B::set1(T()), s1=B::set1(T());
+		const T* end=first+(last-first)/(2*W)*(2*W);
+		for(;first!=end;first+=2*W,b+=2*W)
+		{
+			s0=B::add(s0, B::mul(B::load(first), B::load(b)));
+			s1=B::add(s1, B::mul(B::load(first+W), B::load(b+W)));
+		}
+		end=batch_end(first, last);
+		for(;first!=end;first+=W,b+=W)
+			s0=B::add(s0, B::mul(B::load(first), B::load(b)));
+		return reduce_sum(B::add(s0, s1))+scalar::dot(first, last, b);
+	};
+
+	static void scale_add(const T* first, const T* last, T k, const T* b, T* out)
+	{
+		type vk=B::set1(k);
+		for(const T* end=batch_end(first, last);first!=end;first+=W,b+=W,out+=W)
+			B::store(out, B::add(B::mul(B::load(first), vk), B::load(b)));
+		scalar::scale_add(first, last, k, b, out);
+	};
+
+	static void clamp(T* first, T* last, T lo, T hi)
+	{
+		type vlo=B::set1(lo), vhi=B::set1(hi);
+		T* end=first+(last-first)/W*W;
+		// bounds go first so NaN passes through as in scalar loop
+		for(;first!=end;first+=W)
+			B::store(first, B::min(vhi, B::max(vlo, B::load(first))));
+		scalar::clamp(first, last, lo, hi);
+	};
+
+	static void compare_mask(const T* first, const T* last, T value, compare_op op, uint32_t* mask)
+	{
+		// W divides 32, so a batch never straddles mask words
+		type v=B::set1(value);
+		uint32_t word=0;
+		uint32_t bit=0;
+		for(const T* end=batch_end(first, last);first!=end;first+=W)
+		{
+			type a=B::load(first);
+			uint32_t m=(op==compare_eq)?B::eq(a, v):(op==compare_lt)?B::lt(a, v):B::gt(a, v);
+			word|=m<<bit;
+			bit+=W;
+			if(bit==32)
+			{
+				*mask++=word;
+				word=0;
+				bit=0;
+			}
+		}
+		// finish current word with scalar part
+		for(;first!=last;first++)
+		{
+			word|=uint32_t(compare(*first, value, op))<<bit;
+			if(++bit==32)
+			{
+				*mask++=word;
+				word=0;
+				bit=0;
+			}
+		}
+		if(bit)
+			*mask=word;
+	};
+};
+
+};//namespace _internal
+
+/**
+ *  @brief first element equal to value, last if there is none
+ */
+template <class T>
+const T* find(const T* first, const T* last, typename _internal::value_of<T>::type value)
+{
+	return _internal::kernel<T>::find(first, last, value);
+}
+
+template <class T, class S>
+typename vector<T, S>::const_iterator find(const vector<T, S>& v, typename _internal::value_of<T>::type value)
+{
+	return typename vector<T, S>::const_iterator(find(v.data(), v.data()+v.size(), value));
+}
+
+/**
+ *  @brief number of elements equal to value
+ */
+template <class T>
+size_type count(const T* first, const T* last, typename _internal::value_of<T>::type value)
+{
+	return _internal::kernel<T>::count(first, last, value);
+}
+
+template <class T, class S>
+S count(const vector<T, S>& v, typename _internal::value_of<T>::type value)
+{
+	return S(count(v.data(), v.data()+v.size(), value));
+}
+
+/**
+ *  @brief smallest element, range should not be empty
+ */
+template <class T>
+T min(const T* first, const T* last)
+{
+	if(first==last)
+	{
+		UBOOST_ASSERT(false);
+		return T();
+	}
+	return _internal::kernel<T>::min(first, last);
+}
+
+template <class T, class S>
+T min(const vector<T, S>& v)
+{
+	return min(v.data(), v.data()+v.size());
+}
+
+/**
+ *  @brief largest element, range should not be empty
+ */
+template <class T>
+T max(const T* first, const T* last)
+{
+	if(first==last)
+	{
+		UBOOST_ASSERT(false);
+		return T();
+	}
+	return _internal::kernel<T>::max(first, last);
+}
+
+template <class T, class S>
+T max(const vector<T, S>& v)
+{
+	return max(v.data(), v.data()+v.size());
+}
+
+/**
+ *  @brief sum of elements, accumulated in T
+ */
+template <class T>
+T sum(const T* first, const T* last)
+{
+	return _internal::kernel<T>::sum(first, last);
+}
+
+template <class T, class S>
+T sum(const vector<T, S>& v)
+{
+	return sum(v.data(), v.data()+v.size());
+}
+
+/**
+ *  @brief sum of first[i]*b[i], b should hold at least last-first elements
+ */
+template <class T>
+T dot(const T* first, const T* last, const T* b)
+{
+	return _internal::kernel<T>::dot(first, last, b);
+}
+
+template <class T, class S>
+T dot(const vector<T, S>& a, const vector<T, S>& b)
+{
+	UBOOST_ASSERT(a.size()==b.size());
+	return dot(a.data(), a.data()+a.size(), b.data());
+}
+
+/**
+ *  @brief out[i]=first[i]*k+b[i], out may be the same as first or b
+ */
+template <class T>
+void scale_add(const T* first, const T* last, typename _internal::value_of<T>::type k, const T* b, T* out)
+{
+	_internal::kernel<T>::scale_add(first, last, k, b, out);
+}
+
+// out is resized to a.size()
+template <class T, class S>
+void scale_add(const vector<T, S>& a, typename _internal::value_of<T>::type k, const vector<T, S>& b, vector<T, S>& out)
+{
+	UBOOST_ASSERT(a.size()==b.size());
+	out.resize(a.size(), T());
+	scale_add(a.data(), a.data()+a.size(), k, b.data(), out.data());
+}
+
+/**
+ *  @brief limit every element to [lo, hi] in place
+ */
+template <class T>
+void clamp(T* first, T* last, typename _internal::value_of<T>::type lo,
+           typename _internal::value_of<T>::type hi)
+{
+	_internal::kernel<T>::clamp(first, last, lo, hi);
+}
+
+template <class T, class S>
+void clamp(vector<T, S>& v, typename _internal::value_of<T>::type lo,
+           typename _internal::value_of<T>::type hi)
+{
+	clamp(v.data(), v.data()+v.size(), lo, hi);
+}
+
+/**
+ *  @brief set bit i%32 of mask[i/32] if (first[i] op value) holds. mask
+ *  should hold (last-first+31)/32 words, unused bits of the last word
+ *  are cleared
+ */
+template <class T>
+void compare_mask(const T* first, const T* last, typename _internal::value_of<T>::type value, compare_op op, uint32_t* mask)
+{
+	_internal::kernel<T>::compare_mask(first, last, value, op, mask);
+}
+
+template <class T, class S>
+void compare_mask(const vector<T, S>& v, typename _internal::value_of<T>::type value, compare_op op, uint32_t* mask)
+{
+	compare_mask(v.data(), v.data()+v.size(), value, op, mask);
+}
+
+};//namespace simd
+
+};//namespace uboost
+
+#endif /* UBOOST_ALGORITHM_SIMD_HPP_ */
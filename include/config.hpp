@@ -51,6 +51,54 @@
 #include "port/iar-gcc/port.hpp"
 #elif USE_COMPILER_MODE==COMPILER_X86_GCC
 #define UBOOST_MOST_STRICT_ALIGNMENT uint32_t
+#ifndef UBOOST_SIZE_TYPE
+#define UBOOST_SIZE_TYPE uint32_t
+#define UBOOST_PTRDIFF_TYPE int32_t
+#endif
+#ifndef UBOOST_CACHE_LINE_SIZE
+#define UBOOST_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+/**
+ * Default type of container size/index(uboost::size_type) and of iterator
+ * difference(uboost::ptrdiff_t). Containers take their own index type as
+ * template parameter, this one is only used when it is not given.
+ * Both can be defined before including uboost headers.
+ */
+#ifndef UBOOST_SIZE_TYPE
+#define UBOOST_SIZE_TYPE uint16_t
+#endif
+#ifndef UBOOST_PTRDIFF_TYPE
+#define UBOOST_PTRDIFF_TYPE int16_t
+#endif
+
+/**
+ * Cache line size of target, used as alignment of containers declared to
+ * be cache-line aligned(see uboost::cache_line_size). Targets without data
+ * cache keep it at 1.
+ */
+#ifndef UBOOST_CACHE_LINE_SIZE
+#define UBOOST_CACHE_LINE_SIZE 1
+#endif
+
+/**
+ * Runtime checking policy of containers(see UBOOST_ASSERT in uboost.hpp):
+ * - UBOOST_CHECK_UNCHECKED: no check at all, element access is a bare load.
+ *   This is the default and the one production build should use.
+ * - UBOOST_CHECK_CHECKED: range and precondition violations are reported to
+ *   uboost check handler(trap by default, see uboost::set_check_handler).
+ * - UBOOST_CHECK_DEBUG: checked, plus containers track their iterators so
+ *   use of invalidated iterator is reported as well. Container and iterator
+ *   layout differs in this mode, so every translation unit should be built
+ *   with the same mode.
+ */
+#define UBOOST_CHECK_UNCHECKED 0
+#define UBOOST_CHECK_CHECKED   1
+#define UBOOST_CHECK_DEBUG     2
+
+#ifndef UBOOST_CHECK_MODE
+#define UBOOST_CHECK_MODE UBOOST_CHECK_UNCHECKED
 #endif
 
 #endif /* UBOOST_H_ */
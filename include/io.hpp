@@ -0,0 +1,157 @@
+/**@file io.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * POSIX file descriptor I/O directly on uboost::vector storage. read()
+ * fills vector spare capacity and only commits complete elements(bytes of
+ * a partial one are kept for the next call),
+ * writev() gathers data of one or more vectors in one system call, so no
+ * staging buffer is needed in between. Only available on POSIX targets.
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 18:02:31 2026 okyfirmansyah
+ */
+
+#include "config.hpp"
+
+#ifndef UBOOST_IO_HPP_
+#define UBOOST_IO_HPP_
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include "uboost.hpp"
+#include "vector.hpp"
+
+namespace uboost
+{
+namespace io
+{
+
+/**
+ *  @brief bytes of an element read only partially by read(), they are
+ *  kept in spare capacity of the vector right after its last element
+ */
+struct remainder
+{
+	remainder()
+	:bytes(0){};
+
+	size_t bytes;
+};
+
+/**
+ *  @brief read at most max elements from fd into spare capacity of v
+ *
+ *  Elements are appended after the current ones, vector size only grows by
+ *  the number of complete elements read. If read() returns part of an
+ *  element, the rest of it is read before returning. When end of file,
+ *  error or EAGAIN comes first, bytes of that element are kept right after
+ *  the last element of v and counted in rest, next call continues with them
+ *  (so v should not be modified in between). No byte read from fd is ever
+ *  dropped. Interrupted call is retried.
+ *
+ *  @return number of elements appended, 0 on end of file or when there is
+ *  no spare capacity, -1 on error when no element is appended(errno is
+ *  kept, error after some elements are appended is reported by next call)
+ */
+template <class T, class S>
+ssize_t read(int fd, vector<T, S>& v, remainder& rest, size_type max=size_type(-1))
+{
+	size_type n=v.capacity()-v.size();
+	if(max<n)
+		n=max;
+	if(!n)
+		return 0;
+	UBOOST_ASSERT(rest.bytes<sizeof(T));
+
+	S start=v.size();
+	uint8_t* p=reinterpret_cast<uint8_t*>(v.append_uninitialized(n));
+	size_t want=size_t(n)*sizeof(T);
+	size_t got=rest.bytes;
+	ssize_t r;
+	while(true)
+	{
+		r=::read(fd, p+got, want-got);
+		if(r<0)
+		{
+			if(errno==EINTR)
+				continue;
+			break;
+		}
+		got+=size_t(r);
+		// only keep reading to complete partially read element
+		if(r==0 || got%sizeof(T)==0)
+			break;
+	}
+	size_type complete=size_type(got/sizeof(T));
+	// partial element stays right past the new size
+	v.resize_for_overwrite(S(start+complete));
+	rest.bytes=got%sizeof(T);
+	if(r<0 && !complete)
+		return -1;
+	return ssize_t(complete);
+};
+
+/**
+ *  @brief read() of byte sized elements, which can not be read partially
+ */
+template <class T, class S>
+ssize_t read(int fd, vector<T, S>& v, size_type max=size_type(-1))
+{
+	static_assert(sizeof(T)==1, "element may be read partially, pass io::remainder");
+	remainder rest;
+	return read(fd, v, rest, max);
+};
+
+namespace _internal
+{
+
+inline void fill_iovec(struct iovec*)
+{
+};
+
+template <class T, class S, class... Vectors>
+void fill_iovec(struct iovec* iov, const vector<T, S>& v, const Vectors&... rest)
+{
+	iov->iov_base=const_cast<T*>(v.data());
+	iov->iov_len=size_t(v.size())*sizeof(T);
+	fill_iovec(iov+1, rest...);
+};
+
+};//namespace _internal
+
+/**
+ *  @brief write content of every vector, in argument order, with single
+ *  writev() call. Like writev(), it may write less than requested
+ *  @return number of bytes written, -1 on error(errno is kept)
+ */
+template <class... Vectors>
+ssize_t writev(int fd, const Vectors&... v)
+{
+	static_assert(sizeof...(Vectors)>0, "writev needs at least one vector");
+	struct iovec iov[sizeof...(Vectors)];
+	_internal::fill_iovec(iov, v...);
+	ssize_t r;
+	do
+	{
+		r=::writev(fd, iov, int(sizeof...(Vectors)));
+	}while(r<0 && errno==EINTR);
+	return r;
+};
+
+};//namespace io
+};//namespace uboost
+
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+#endif /* UBOOST_IO_HPP_ */
@@ -53,11 +53,6 @@ struct output_iterator_tag {};
  */
 struct random_access_iterator_tag {};
 
-/**
- *  @brief defines suitable integer type to contains
- *  difference between two pointer of object
- */
-typedef int16_t ptrdiff_t;
 
 /**
  *  @brief Base class of all iterator. This struct
@@ -117,6 +112,56 @@ struct iterator_traits<const T*>
 	typedef const T& reference;
 };
 
+/**
+ *  @brief obtain raw element pointer of a contiguous iterator(raw pointer
+ *  or container iterator whose operator->() does not dereference), without
+ *  dereferencing it so end iterator is accepted
+ */
+template<class T>
+T* to_address(T* p)
+{
+	return p;
+}
+
+template<class Iter>
+auto to_address(const Iter& it)->decltype(it.operator->())
+{
+	return it.operator->();
+}
+
+namespace _internal
+{
+
+template<class Iter>
+typename iterator_traits<Iter>::difference_type
+distance(Iter first, Iter last, random_access_iterator_tag)
+{
+	return last-first;
+}
+
+template<class Iter, class Tag>
+typename iterator_traits<Iter>::difference_type
+distance(Iter first, Iter last, Tag)
+{
+	typename iterator_traits<Iter>::difference_type n=0;
+	for(;first!=last;++first)
+		n++;
+	return n;
+}
+
+};//namespace _internal
+
+/**
+ *  @brief number of increments from first to last, constant time for
+ *  random access iterator
+ */
+template<class Iter>
+typename iterator_traits<Iter>::difference_type distance(Iter first, Iter last)
+{
+	return _internal::distance(first, last,
+	                           typename iterator_traits<Iter>::iterator_category());
+}
+
 /**
  *  @brief Predefined iterator: back_insert_iterator
  *  (please refer to C++11 iterator reference)
@@ -355,6 +400,11 @@ class move_iterator
 		return *this;
 	}
 
+	difference_type operator-(const move_iterator& C) const
+	{
+		return cur-C.cur;
+	};
+
 	auto operator[](difference_type n) const ->decltype(move(cur[n]))
 	{
 		return move(cur[n]);
@@ -412,10 +462,11 @@ class reverse_iterator
 	explicit reverse_iterator(Iterator it)
 	:cur(it){};
 	template <class Iter> reverse_iterator(const reverse_iterator<Iter>& it)
-	:cur(it.cur){};
+	:cur(it.base()){};
 	template <class Iter> reverse_iterator& operator=(const reverse_iterator<Iter>& it)
 	{
-		cur = it.cur;
+		cur = it.base();
+		return *this;
 	};
 
 	iterator_type base() const
@@ -425,12 +476,14 @@ class reverse_iterator
 
 	pointer operator->() const
 	{
-		return cur[-1];
+		return &(operator*());
 	};
 
+	// only requires bidirectional iterator
 	reference operator*() const
 	{
-		return cur[-1];
+		Iterator temp = cur;
+		return *--temp;
 	};
 
 	reverse_iterator& operator++()
@@ -480,9 +533,14 @@ class reverse_iterator
 		return *this;
 	}
 
+	difference_type operator-(const reverse_iterator& C) const
+	{
+		return C.cur-cur;
+	};
+
 	auto operator[](difference_type n) const ->decltype(cur[n])
 	{
-		return cur[n-1];
+		return cur[-n-1];
 	}
 
 
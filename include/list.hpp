@@ -28,40 +28,207 @@ namespace uboost
 namespace _internal
 {
 
+// links of one pool item, use index instead pointer, null is marked by
+// Idx=MAX(Idx)
+template <class Idx>
+struct listlink
+{
+    // null index marker of links
+    static const Idx null_idx=Idx(-1);
+
+    Idx nextIdx;
+    Idx prevIdx;
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+    // bumped whenever item is freed, iterators keep the one they saw
+    uint16_t gen;
+#endif
+};
+
+// space of one contained object
 template <class T>
-struct listitem
+struct listslot
+{
+    alignas(T) uint8_t buf[sizeof(T)];
+
+    T& get()
+    {
+        return *reinterpret_cast<T*>(buf);
+    };
+
+    const T& get() const
+    {
+        return *reinterpret_cast<const T*>(buf);
+    };
+};
+
+// content followed by its links, as one array element
+template <class T, class Idx>
+struct listitem:listslot<T>, listlink<Idx>
 {
-    uint8_t buf[sizeof(T)];
+};
 
-    // use index instead pointer, null is marked by Idx=MAX(uint16_t)
-    uint16_t nextIdx;
-    uint16_t prevIdx;
+// word of listpool occupancy bitmap, bit i of word w is item w*32+i
+typedef uint32_t bitmap_word;
+const size_type bitmap_word_bits=32;
+
+// index of lowest set bit, w should not be zero
+inline size_type lowest_bit(bitmap_word w)
+{
+#if defined(__GNUC__)
+    return size_type(__builtin_ctz(w));
+#else
+    size_type i=0;
+    while(!(w&1))
+    {
+        w>>=1;
+        i++;
+    }
+    return i;
+#endif
 };
 
 }; // namespace internal
 
-template <class T>
+/**
+ *  @brief listpool layout keeping links of each item right after its
+ *  content, in one array(default). Visiting an item touches a single place
+ *  in memory, best when contained objects are small
+ */
+struct interleaved_layout
+{
+    template <class T, class Idx>
+    struct storage
+    {
+        typedef _internal::listitem<T, Idx> item_type;
+
+        storage(item_type* __items)
+        :_items(__items){};
+
+        _internal::listlink<Idx>& link(Idx idx) const
+        {
+            return _items[idx];
+        };
+
+        item_type& slot(Idx idx) const
+        {
+            return _items[idx];
+        };
+
+        item_type* _items;
+    };
+
+    template <class T, class Idx, uint64_t cap, size_type Align>
+    struct buffer
+    {
+        typedef _internal::listitem<T, Idx> item_type;
+
+        storage<T, Idx> get()
+        {
+            return storage<T, Idx>(_items);
+        };
+
+        alignas(item_type) alignas(Align) item_type _items[cap];
+    };
+};
+
+/**
+ *  @brief listpool layout keeping links of all items in one array and
+ *  contents in another one. Walking links(find position, count, splice,
+ *  sort, ...) stays within the compact link array instead of touching one
+ *  cache line per item, best when contained objects are large
+ */
+struct split_layout
+{
+    template <class T, class Idx>
+    struct storage
+    {
+        typedef _internal::listslot<T> item_type;
+
+        storage(_internal::listlink<Idx>* __links, item_type* __items)
+        :_links(__links),_items(__items){};
+
+        _internal::listlink<Idx>& link(Idx idx) const
+        {
+            return _links[idx];
+        };
+
+        item_type& slot(Idx idx) const
+        {
+            return _items[idx];
+        };
+
+        _internal::listlink<Idx>* _links;
+        item_type* _items;
+    };
+
+    template <class T, class Idx, uint64_t cap, size_type Align>
+    struct buffer
+    {
+        typedef _internal::listlink<Idx> link_type;
+        typedef _internal::listslot<T> item_type;
+
+        storage<T, Idx> get()
+        {
+            return storage<T, Idx>(_links, _items);
+        };
+
+        alignas(link_type) alignas(Align) link_type _links[cap];
+        alignas(item_type) alignas(Align) item_type _items[cap];
+    };
+};
+
+template <class T, class Idx=size_type, class Layout=interleaved_layout>
 class list;
 
-template <class T>
+/**
+ *  @brief space holding list items shared by one or more uboost::list
+ *
+ *  Besides the free chain, pool keeps a bitmap of claimed items so all
+ *  live items can be visited in array order(for_each()), as a sequential
+ *  memory scan instead of chasing links.
+ *  @tparam T type of contained object
+ *  @tparam Idx unsigned type of item index and size, pool capacity
+ *  should be less than its maximum value, which marks null links(see
+ *  uboost::index_type)
+ *  @tparam Layout placement of item links and contents in memory,
+ *  uboost::interleaved_layout or uboost::split_layout
+ */
+template <class T, class Idx=size_type, class Layout=interleaved_layout>
 class listpool
 {
     public:
-    listpool(_internal::listitem<T>* __list, uint16_t __cap)
-    :_sz(0),_cap(__cap),_list(__list),_startIdx(-1)
+    typedef Idx size_type;
+    typedef typename Layout::template storage<T, Idx> storage_type;
+    // item as returned by operator[], its content is get()
+    typedef typename storage_type::item_type item_type;
+    typedef uboost::list<T, Idx, Layout> list_type;
+    static const Idx null_idx=_internal::listlink<Idx>::null_idx;
+
+    typedef _internal::bitmap_word bitmap_word;
+
+    // __occupied should hold (__cap+31)/32 words
+    listpool(storage_type __items, bitmap_word* __occupied, Idx __cap)
+    :_items(__items),_occupied(__occupied),_sz(0),_cap(__cap),_startIdx(null_idx),
+     _version(0),_compactVersion(0),_compactList(nullptr),_compactPos(0),_compactTarget(0),_compactIdx(null_idx)
     {
-        uint16_t  i;
+        for(Idx w=0;w<words(_cap);w++)
+            _occupied[w]=0;
+        Idx  i;
         // initialize all list item
         for(i=0;i<_cap;i++)
         {
-            _list[i].nextIdx=i+1;
-            _list[i].prevIdx=i-1;
+            _items.link(i).nextIdx=i+1;
+            _items.link(i).prevIdx=i-1;
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+            _items.link(i).gen=0;
+#endif
         };
         if(i)
         {
-            _list[i-1].nextIdx=-1;
+            _items.link(i-1).nextIdx=null_idx;
+            _items.link(0).prevIdx=null_idx;
+            _startIdx=0;
         };
-        _startIdx=0;
     };
 
     listpool(const listpool&)=delete;
@@ -78,7 +245,7 @@ class listpool
     }
 
     //empty
-	uint16_t free() const
+	Idx free() const
 	{
 		return _cap-_sz;
 	};
@@ -95,61 +262,358 @@ class listpool
 		return _cap;
 	};
 
-	const _internal::listitem<T>& operator[](uint16_t idx) const
+	const item_type& operator[](Idx idx) const
     {
-		return _list[idx];
+		return _items.slot(idx);
 	};
 
-	_internal::listitem<T>& operator[](uint16_t idx)
+	item_type& operator[](Idx idx)
     {
-		return _list[idx];
+		return _items.slot(idx);
+	};
+
+	void free(Idx idx)
+	{
+        if(!UBOOST_CHECK(idx<_cap))
+            return;
+        free_chain(idx, idx, 1);
+	};
+
+	// true if item idx is claimed
+	bool occupied(Idx idx) const
+	{
+	    UBOOST_ASSERT(idx<_cap);
+	    return (_occupied[idx/_internal::bitmap_word_bits]>>(idx%_internal::bitmap_word_bits))&1;
+	};
+
+	// call f(item content) for every claimed item in array order,
+	// regardless of the list it belongs to
+	template <class F>
+	void for_each(F f)
+	{
+	    for_each_range(0, _cap, f);
 	};
 
-	void free(uint16_t idx)
+	// same as for_each(), only for items with index in [first, last). Lets
+	// several workers sweep disjoint parts of the pool
+	template <class F>
+	void for_each_range(Idx first, Idx last, F f)
 	{
-        if(_startIdx!=-1)
-	        _list[_startIdx].prevIdx=idx;
-	    _list[idx].nextIdx=_startIdx;
-	    _list[idx].prevIdx=-1;
-	    _startIdx=idx;
+	    const size_type bits=_internal::bitmap_word_bits;
+	    if(last>_cap)
+	        last=_cap;
+	    if(first>=last)
+	        return;
+	    Idx lastWord=Idx((last-1)/bits);
+	    for(Idx wi=Idx(first/bits);;wi++)
+	    {
+	        Idx base=Idx(wi*bits);
+	        bitmap_word w=_occupied[wi];
+	        if(first>base)
+	            w&=~bitmap_word(0)<<(first-base);
+	        if(last-base<bits)
+	            w&=(bitmap_word(1)<<(last-base))-1;
+	        while(w)
+	        {
+	            f(_items.slot(base+_internal::lowest_bit(w)).get());
+	            w&=w-1;
+	        }
+	        if(wi==lastWord)
+	            break;
+	    }
 	};
 
-	uint16_t claim()
+	// return null_idx if pool is exhausted
+	Idx claim()
 	{
-	    if(!_startIdx)
-	        return -1;
+	    if(_startIdx==null_idx)
+	    {
+	        UBOOST_ASSERT(false);
+	        return null_idx;
+	    }
         else
         {
-            uint16_t idx=_startIdx;
-            _startIdx=_list[_startIdx].nextIdx;
-            if(_startIdx!=-1)
-                _list[_startIdx].prevIdx=-1;
+            Idx idx=_startIdx;
+            _version++;
+            _startIdx=_items.link(_startIdx).nextIdx;
+            if(_startIdx!=null_idx)
+                _items.link(_startIdx).prevIdx=null_idx;
+            mark(idx, true);
+            _sz++;
             return idx;
         }
 	};
 
+    /**
+     *  @brief renumber item slots so the given lists are laid out in
+     *  array order, one after another, starting from item 0. Free items
+     *  end up after them, chained in array order.
+     *
+     *  Every list using this pool should be passed. Items are moved by
+     *  move construction/assignment, so T should be movable. Iterators,
+     *  references and pointers to moved items are invalidated(reported in
+     *  UBOOST_CHECK_DEBUG mode).
+     *  @return true once layout is sequential
+     */
+    template <class... Lists>
+    bool compact(Lists&... lists)
+    {
+        return compact_step(null_idx, lists...);
+    };
+
+    /**
+     *  @brief incremental compact(), handles at most k items(moved or
+     *  found in place) per call so it can run in idle time. Next call
+     *  resumes where this one stopped, as long as lists are passed in the
+     *  same order and neither they nor the pool are modified in between;
+     *  otherwise it starts over from item 0
+     *  @return true once layout is sequential
+     */
+    template <class... Lists>
+    bool compact_step(Idx k, Lists&... lists)
+    {
+        static_assert(sizeof...(Lists)>0, "compact needs at least one list");
+        list<T, Idx, Layout>* ls[]={&lists...};
+        return compact_lists(ls, sizeof...(Lists), k);
+    };
+
     private:
-    _internal::listitem<T>* _list;
-    uint16_t _sz;
-    uint16_t _cap;
+    bool compact_lists(list<T, Idx, Layout>** ls, size_type n, Idx k)
+    {
+        // a list left out would have its items overwritten
+        Idx total=0;
+        for(size_type i=0;i<n;i++)
+            total+=ls[i]->_sz;
+        if(total!=_sz)
+        {
+            UBOOST_ASSERT(false);
+            return false;
+        }
 
-    // use index instead pointer, null is marked by Idx=MAX(uint16_t)
-    uint16_t _startIdx;
-	friend class list<T>;
+        size_type l=0;
+        Idx target=0;
+        Idx i=ls[0]->_firstIdx;
+        if(_compactList && _version==_compactVersion &&
+           _compactPos<n && ls[_compactPos]==_compactList)
+        {
+            l=_compactPos;
+            target=_compactTarget;
+            i=_compactIdx;
+        }
+        _compactList=nullptr;
+
+        Idx steps=0;
+        for(;;)
+        {
+            for(;i!=null_idx;i=_items.link(i).nextIdx,target++,steps++)
+            {
+                if(steps==k)
+                {
+                    // item i is the next one to be placed at target
+                    _compactList=ls[l];
+                    _compactPos=l;
+                    _compactTarget=target;
+                    _compactIdx=i;
+                    _compactVersion=_version;
+                    return false;
+                }
+                if(i!=target)
+                {
+                    swap_slots(target, i, ls[l], ls, n);
+                    i=target;
+                }
+            }
+            if(++l==n)
+                break;
+            i=ls[l]->_firstIdx;
+        }
+
+        // free items are all past the lists now
+        for(Idx i=target;i<_cap;i++)
+        {
+            _items.link(i).prevIdx=(i==target)?null_idx:Idx(i-1);
+            _items.link(i).nextIdx=(i+1<_cap)?Idx(i+1):null_idx;
+        }
+        _startIdx=(target<_cap)?target:null_idx;
+        return true;
+    };
+
+    // move item of list lx at slot b to slot a, item at slot a(free or
+    // belonging to one of ls) takes slot b. Links pointing to a and b are
+    // renamed accordingly
+    void swap_slots(Idx a, Idx b, list<T, Idx, Layout>* lx, list<T, Idx, Layout>** ls, size_type n)
+    {
+        storage_type items=_items;
+        bool yLive=occupied(a);
+        Idx xp=items.link(b).prevIdx, xn=items.link(b).nextIdx;
+        Idx yp=items.link(a).prevIdx, yn=items.link(a).nextIdx;
+
+        // list owning item at a, only needed when it is first or last
+        list<T, Idx, Layout>* ly=nullptr;
+        if(yLive && (yp==null_idx || yn==null_idx))
+            for(size_type i=0;i<n && !ly;i++)
+                if(ls[i]->_firstIdx==a || ls[i]->_lastIdx==a)
+                    ly=ls[i];
+
+        if(yLive)
+        {
+            T temp(uboost::move(items.slot(a).get()));
+            items.slot(a).get()=uboost::move(items.slot(b).get());
+            items.slot(b).get()=uboost::move(temp);
+        }else
+        {
+            new(&items.slot(a).buf) T(uboost::move(items.slot(b).get()));
+            items.slot(b).get().~T();
+            mark(a, true);
+            mark(b, false);
+        }
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+        items.link(a).gen++;
+        items.link(b).gen++;
+#endif
+
+        items.link(a).prevIdx=rename(xp, a, b);
+        items.link(a).nextIdx=rename(xn, a, b);
+        items.link(b).prevIdx=rename(yp, a, b);
+        items.link(b).nextIdx=rename(yn, a, b);
+
+        // neighbours which are a or b themselves are renamed above
+        if(xp==null_idx)
+            lx->_firstIdx=a;
+        else if(xp!=a && xp!=b)
+            items.link(xp).nextIdx=a;
+        if(xn==null_idx)
+            lx->_lastIdx=a;
+        else if(xn!=a && xn!=b)
+            items.link(xn).prevIdx=a;
+
+        if(yp==null_idx)
+        {
+            if(!yLive)
+                _startIdx=b;
+            else if(ly)
+                ly->_firstIdx=b;
+        }else if(yp!=a && yp!=b)
+            items.link(yp).nextIdx=b;
+        if(yn==null_idx)
+        {
+            if(yLive && ly)
+                ly->_lastIdx=b;
+        }else if(yn!=a && yn!=b)
+            items.link(yn).prevIdx=b;
+    };
+
+    static Idx rename(Idx idx, Idx a, Idx b)
+    {
+        return (idx==a)?b:((idx==b)?a:idx);
+    };
+
+    // return n items linked from first to last back to pool in one splice,
+    // their content should be destroyed already
+    void free_chain(Idx first, Idx last, Idx n)
+    {
+        _version++;
+        for(Idx i=first;;i=_items.link(i).nextIdx)
+        {
+            mark(i, false);
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+            _items.link(i).gen++;
+#endif
+            if(i==last)
+                break;
+        }
+        _items.link(last).nextIdx=_startIdx;
+        if(_startIdx!=null_idx)
+            _items.link(_startIdx).prevIdx=last;
+        _items.link(first).prevIdx=null_idx;
+        _startIdx=first;
+        _sz-=n;
+    };
+
+    // take n(non zero) items as one linked chain, return its first item
+    // and its last one in last, null_idx if pool doesnt have n free items
+    Idx claim_chain(Idx n, Idx& last)
+    {
+        if(!UBOOST_CHECK(n<=_cap-_sz))
+            return null_idx;
+        _version++;
+        Idx first=_startIdx;
+        last=first;
+        mark(last, true);
+        for(Idx i=1;i<n;i++)
+        {
+            last=_items.link(last).nextIdx;
+            mark(last, true);
+        }
+        _startIdx=_items.link(last).nextIdx;
+        if(_startIdx!=null_idx)
+            _items.link(_startIdx).prevIdx=null_idx;
+        _sz+=n;
+        return first;
+    };
+
+    static Idx words(Idx cap)
+    {
+        return Idx((cap+_internal::bitmap_word_bits-1)/_internal::bitmap_word_bits);
+    };
+
+    void mark(Idx idx, bool claimed)
+    {
+        bitmap_word bit=bitmap_word(1)<<(idx%_internal::bitmap_word_bits);
+        if(claimed)
+            _occupied[idx/_internal::bitmap_word_bits]|=bit;
+        else
+            _occupied[idx/_internal::bitmap_word_bits]&=~bit;
+    };
+
+    storage_type _items;
+    bitmap_word* _occupied;
+    Idx _sz;
+    Idx _cap;
+
+    // use index instead pointer, null is marked by Idx=MAX(Idx)
+    Idx _startIdx;
+
+    // bumped whenever an item is claimed, freed or relinked, compact_step()
+    // resume point below is only valid while it is unchanged
+    uint32_t _version;
+    uint32_t _compactVersion;
+    list<T, Idx, Layout>* _compactList;
+    size_type _compactPos;
+    Idx _compactTarget;
+    Idx _compactIdx;
+	friend class list<T, Idx, Layout>;
 };
 
-template <class T>
+/**
+ *  @brief doubly linked list whose items are kept in a uboost::listpool
+ *
+ *  The list head works as a sentinel: its links are _firstIdx/_lastIdx and
+ *  it is addressed by null_idx, so walking the links is circular through
+ *  the head, end() is simply the head and begin(), end(), rbegin() and
+ *  rend() are O(1). The sentinel lives in list object rather than in the
+ *  pool, so each item of the pool stays available for list content.
+ *  @tparam T type of contained object
+ *  @tparam Idx unsigned type of item index and size, same as the pool one
+ *  @tparam Layout layout of the pool, same as the pool one
+ */
+template <class T, class Idx, class Layout>
 class list
 {
     public:
+    typedef Idx size_type;
+    typedef typename listpool<T, Idx, Layout>::storage_type storage_type;
+    static const Idx null_idx=_internal::listlink<Idx>::null_idx;
+
     typedef T& reference;
 	typedef const T& const_reference;
 	typedef T value_type;
     typedef T* pointer;
     typedef const T* const_pointer;
 
-    explicit list (listpool<T>& listpool)
-    :_listpool(&listpool),_sz(0),_firstIdx(-1),_lastIdx(-1)
+    explicit list (listpool<T, Idx, Layout>& listpool)
+    :_listpool(&listpool),_sz(0),
+     _firstIdx(null_idx),_lastIdx(null_idx)
     {
     }
 
@@ -159,30 +623,44 @@ class list
     list (list&& x)=delete;
 
     //!!!TODO: support constructor variants:
-    //explicit list (listpool<T>& listpool, size_type n);
-    //explicit list (listpool<T>& listpool, size_type n, const value_type& val);
+    //explicit list (listpool<T, Idx, Layout>& listpool, size_type n);
+    //explicit list (listpool<T, Idx, Layout>& listpool, size_type n, const value_type& val);
     //template <class InputIterator>
-    //list (listpool<T>& listpool, InputIterator first, InputIterator last);
-    //list (listpool<T>& listpool, initializer_list<value_type> il);
+    //list (listpool<T, Idx, Layout>& listpool, InputIterator first, InputIterator last);
+    //list (listpool<T, Idx, Layout>& listpool, initializer_list<value_type> il);
 
 
     //destructor
     ~list()
     {
-        resize(0);
+        clear();
     }
 
     //copy operation
     list& operator= (const list& x)
     {
-        assign(x.cbegin(), x.cend());
+        if(this!=&x)
+            assign(x.cbegin(), x.cend());
+        return *this;
     };
     //move operation
     list& operator= (list&& x)
     {
-        assign(move_iterator<decltype(x.begin())>(x.begin()),
-	           move_iterator<decltype(x.end())>(x.end()));
-        x.clear();
+        if(this!=&x)
+        {
+            if(_listpool==x._listpool)
+            {
+                // same pool: just relink, nothing is moved
+                clear();
+                splice(cend(), x);
+            }else
+            {
+                assign(move_iterator<decltype(x.begin())>(x.begin()),
+	                   move_iterator<decltype(x.end())>(x.end()));
+                x.clear();
+            }
+        }
+        return *this;
     };
     //TODO: support initializer_list
     //list& operator= (initializer_list<value_type> il);
@@ -192,174 +670,150 @@ class list
 	struct iterator_base
 	{
 	    public:
-		typedef random_access_iterator_tag  iterator_category;
+		typedef bidirectional_iterator_tag  iterator_category;
 		typedef T                           value_type;
-		typedef ptrdiff_t                   difference_type;
+		typedef typename make_difference<Idx>::type difference_type;
 		typedef typename conditional<is_const,const T*,T*>::type  pointer;
 		typedef typename conditional<is_const,const T&,T&>::type  reference;
 		typedef typename conditional<is_const,const list*,list*>::type container_ptr_type;
 
-        iterator_base(typename conditional<is_const,const list&,list&>::type x,
-	                  const ptrdiff_t &_pos):container(&x),end(false)
-        {
-             //determines idx from pos here
-             idx=container->_firstIdx;
-             int i=0;
-             while((idx!=-1) && i<_pos)
-             {
-                 idx=container->_listpool->_list[idx].nextIdx;
-                 i++;
-             }
-             if(idx==-1)end=true;
-        };
-		
-		//template <bool _is_const>
-		iterator_base(const iterator_base<true> & it) //cross copy constructor
-		{
-			container=static_cast<iterator_base<is_const>::container_ptr_type>(it.container);
-			end=it.end;
-			idx=it.idx;
-		}
-		
-		//template <bool _is_const>
-		iterator_base& operator= (const iterator_base<true>& it)//cross assign operator
+		iterator_base()
+		:container(nullptr),idx(null_idx)
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		,gen(0)
+#endif
+		{};
+
+		// null_idx is end(the list sentinel)
+		iterator_base(container_ptr_type x, Idx _idx)
+		:container(x)
 		{
-			container=static_cast<iterator_base<is_const>::container_ptr_type>(it.container);
-			end=it.end;
-			idx=it.idx;
-			return *this;
+		    locate(_idx);
 		};
-		
 
+		// iterator to const_iterator conversion only
+		template <bool _is_const, class=typename enable_if<!_is_const || is_const>::type>
+		iterator_base(const iterator_base<_is_const> & it)
+		:container(it.container),idx(it.idx)
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		,gen(it.gen)
+#endif
+		{
+		}
 
         iterator_base& operator++()
 		{
-		    if(!end)
-			    idx=container._listpool[idx].nextIdx;
-            end=(idx==-1);
+		    check();
+		    locate(container->next_of(idx));
 			return *this;
 		};
 
 		iterator_base operator++(int)
 		{
 			iterator_base temp = *this;
-			if(!end)
-			    idx=container._listpool[idx].nextIdx;
-            end=(idx==-1);
+			++(*this);
 			return temp;
 		};
 
 		iterator_base& operator--()
 		{
-		    if(end)
-		    {
-		        idx=container->_lastidx;
-		        end=(idx==-1);
-            }else
-			    idx=container->_listpool->_list[idx].prevIdx;
+		    if(idx!=null_idx)
+		        check();
+		    locate(container->prev_of(idx));
 			return *this;
 		};
 
 		iterator_base operator--(int)
 		{
 			iterator_base temp = *this;
-			if(end)
-		    {
-		        idx=container->_lastIdx;
-		        end=(idx==-1);
-            }else
-			    idx=container->_listpool->_list[idx].prevIdx;
+			--(*this);
 			return temp;
 		}
 
 		template<bool _B>
 		bool operator==(const iterator_base<_B>& C) const
 		{
-			return (idx==C.idx)&&(end==C.end);
+			return (idx==C.idx);
 		};
 
 		template<bool _B>
 		bool operator!=(const iterator_base<_B>&C) const
 		{
-			return (idx!=C.idx)||(end!=C.end);
+			return (idx!=C.idx);
 		};
 
-
-        //!!!TODO: do we really have to implement these?
-		//template<bool _B>
-		//bool operator<(const iterator_base<_B>&C) const;
-
-		//template<bool _B>
-		//bool operator>(const iterator_base<_B>&C) const;
-
-		//template<bool _B>
-		//bool operator<=(const iterator_base<_B>&C) const;
-
-		//template<bool _B>
-		//bool operator>=(const iterator_base<_B>&C) const;
-
-
         reference operator*() const
 		{
-			return container._listpool[idx];
+		    check();
+			return container->_listpool->_items.slot(idx).get();
 		};
 
         pointer operator->() const
 		{
-			return &(container._listpool[idx]);
+		    check();
+			return &(container->_listpool->_items.slot(idx).get());
 		};
 
-
-
+        // below walk one item per step, as any bidirectional iterator
         reference operator[](difference_type pos) const
 		{
-             uint16_t k=idx;
-             int i=0;
-             while((k!=-1) && i<pos)
-             {
-                 k=container._listpool[k].nextIdx;
-                 i++;
-             }
-             return &(container._listpool[k]);
+             return *((*this)+pos);
 		};
 
 		iterator_base operator+(difference_type n)const
 		{
-			 iterator_base temp=*this;
-
-             for(int i=0;i<n;i++)temp++;
-
+			iterator_base temp=*this;
+			temp+=n;
 			return temp;
 		};
 
 		iterator_base operator-(difference_type n)const
 		{
 			iterator_base temp=*this;
-
-            for(int i=0;i<n;i++)temp--;
-
+			temp-=n;
 			return temp;
 		};
 
 		iterator_base& operator+=(difference_type n)
 		{
-			for(int i=0;i<n;i++)(*this)++;
+			for(difference_type i=0;i<n;i++)++(*this);
 			return *this;
 		};
 
 		iterator_base& operator-= (difference_type n)
 		{
-			for(int i=0;i<n;i++)(*this)--;
+			for(difference_type i=0;i<n;i++)--(*this);
 			return *this;
 		}
 
-		uint16_t get_idx()const{return idx;};
+		Idx get_idx()const{return idx;};
 
         private:
+        void locate(Idx _idx)
+        {
+            idx=_idx;
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+            gen=(idx==null_idx)?0:container->_listpool->_items.link(idx).gen;
+#endif
+        };
+
+        // iterator should point to an item that is not erased since
+        // iterator was created(the latter only in debug mode)
+        void check() const
+        {
+            UBOOST_ASSERT(idx!=null_idx);
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+            UBOOST_ASSERT(idx==null_idx || container->_listpool->_items.link(idx).gen==gen);
+#endif
+        };
+
         container_ptr_type  container;
-		uint16_t idx;
-		bool end;
-		friend class list<T>;
+		Idx idx;
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		uint16_t gen;
+#endif
+		friend class list<T, Idx, Layout>;
+		template <bool> friend struct iterator_base;
 	};
 	public:
     typedef iterator_base<false>       iterator;
@@ -372,68 +826,68 @@ class list
     //begin
 	iterator begin()
 	{
-		return iterator(*this, 0);
+		return iterator(this, _firstIdx);
 	};
 
 	const_iterator begin() const
 	{
-		return const_iterator(*this, 0);
+		return const_iterator(this, _firstIdx);
 	};
 
 	//end
 	iterator end()
 	{
-		return iterator(*this, _sz);
+		return iterator(this, null_idx);
 	};
 
 	const_iterator end() const
 	{
-		return const_iterator(*this, _sz);
+		return const_iterator(this, null_idx);
 	};
 
 	//cbegin
 	const_iterator cbegin() const
 	{
-		return const_iterator(*this, 0);
+		return begin();
 	};
 
 	//cend
 	const_iterator cend() const
 	{
-		return const_iterator(*this, _sz);
+		return end();
 	};
 
 	//constant reverse iterators
 	const_reverse_iterator crbegin() const
 	{
-		return const_reverse_iterator(const_iterator(*this, 0));
+		return const_reverse_iterator(cend());
 	};
 
 	const_reverse_iterator crend() const
 	{
-		return const_reverse_iterator(const_iterator(*this, _sz));
+		return const_reverse_iterator(cbegin());
 	};
 
 	//rbegin
 	reverse_iterator rbegin()
 	{
-		return reverse_iterator(iterator(*this, 0));
+		return reverse_iterator(end());
 	};
 
 	const_reverse_iterator rbegin() const
 	{
-		return const_reverse_iterator(const_iterator(*this, 0));
+		return const_reverse_iterator(end());
 	};
 
 	//rend
 	reverse_iterator rend()
 	{
-		return reverse_iterator(iterator(*this, _sz));
+		return reverse_iterator(begin());
 	};
 
 	const_reverse_iterator rend() const
 	{
-		return const_reverse_iterator(const_iterator(*this, _sz));
+		return const_reverse_iterator(begin());
 	};
 
     //empty
@@ -457,43 +911,52 @@ class list
 
     reference front()
     {
-        return _listpool[_firstIdx];
+        UBOOST_ASSERT(_sz);
+        return _listpool->_items.slot(_firstIdx).get();
     }
 
     const_reference front() const
     {
-        return _listpool[_firstIdx];
+        UBOOST_ASSERT(_sz);
+        return _listpool->_items.slot(_firstIdx).get();
     };
 
     reference back()
     {
-        return _listpool[_lastIdx];
+        UBOOST_ASSERT(_sz);
+        return _listpool->_items.slot(_lastIdx).get();
     };
 
     const_reference back() const
     {
-        return _listpool[_lastIdx];
+        UBOOST_ASSERT(_sz);
+        return _listpool->_items.slot(_lastIdx).get();
     };
 
+    // existing items are assigned in place, then the rest is appended or
+    // erased
     template <class InputIterator>
-      void assign (InputIterator first, InputIterator last)
+      typename enable_if<!is_integral<InputIterator>::value>::type
+      assign (InputIterator first, InputIterator last)
     {
-        //!!!TODO: need to optimize this
-        resize(0);
-        for(InputIterator it=first;
-            it!=last ;
-            it++)
-        {
-            push_front(*it);
-        }
+        iterator it=begin();
+        for(;first!=last && it!=end();++first,++it)
+            *it=*first;
+        if(it!=end())
+            erase(it, end());
+        for(;first!=last;++first)
+            emplace_back(*first);
     };
 
     void assign (size_type n, const value_type& val)
     {
-        //!!!TODO: need to optimize this
-        resize(0);
-        for(size_type i=0;i<n;i++)
-            push_back(val);
+        iterator it=begin();
+        for(;n && it!=end();n--,++it)
+            *it=val;
+        if(it!=end())
+            erase(it, end());
+        else
+            emplace_n(null_idx, n, val);
     };
     // TODO: support initializer_list
     //void assign (initializer_list<value_type> il);
@@ -502,15 +965,7 @@ class list
     template <class... Args>
       void emplace_front (Args&&... args)
     {
-        uint16_t idx=_listpool.claim();
-        _listpool._list[idx].nextIdx=_firstIdx;
-        _listpool._list[idx].prevIdx=-1;
-        if(_firstIdx!=-1)
-            _listpool._list[_firstIdx].prevIdx=idx;
-        _firstIdx=idx;
-        _sz++;
-
-        new(&_listpool._list[_firstIdx].buf) value_type(uboost::forward<Args>(args)...);
+        emplace(cbegin(), uboost::forward<Args>(args)...);
     };
 
 
@@ -526,28 +981,18 @@ class list
 
     void pop_front()
     {
-        // call destructor manually
-        ( (T*)_listpool._list[_firstIdx].buf)->~T();
-
-        uint16_t idx=_listpool._list[_firstIdx].nextIdx;
-        if(idx!=-1)
-            _listpool._list[idx].prevIdx=-1;
-        _listpool.free(_firstIdx);
-        _firstIdx=idx;
+        if(!_sz)
+        {
+            UBOOST_ASSERT(false);
+            return;
+        }
+        erase_idx(_firstIdx);
     };
 
     template <class... Args>
       void emplace_back (Args&&... args)
     {
-        uint16_t idx=_listpool->claim();
-        _listpool->_list[idx].nextIdx=-1;
-        _listpool->_list[idx].prevIdx=_lastIdx;
-        if(_lastIdx!=-1)
-            _listpool->_list[_lastIdx].nextIdx=idx;
-        _lastIdx=idx;
-        _sz++;
-
-        new(&_listpool->_list[_lastIdx].buf) value_type(uboost::forward<Args>(args)...);
+        emplace(cend(), uboost::forward<Args>(args)...);
     };
 
     void push_back (const value_type& val)
@@ -562,58 +1007,23 @@ class list
 
     void pop_back()
     {
-        // call destructor manually
-        ( (T*)_listpool._list[_lastIdx].buf)->~T();
-
-        uint16_t idx=_listpool._list[_lastIdx].prevIdx;
-        if(idx!=-1)
-            _listpool._list[idx].nextIdx=-1;
-        _listpool.free(_lastIdx);
-        _lastIdx=idx;
+        if(!_sz)
+        {
+            UBOOST_ASSERT(false);
+            return;
+        }
+        erase_idx(_lastIdx);
     };
 
     template <class... Args>
       iterator emplace (const_iterator position, Args&&... args)
     {
-        uint16_t dstIdx=position.get_idx();
-
-        uint16_t idx=_listpool.claim();
-        _listpool._list[idx].nextIdx=dstIdx;
-
-
-
-        if(dstIdx!=-1)
-        {
-            _listpool._list[idx].prevIdx=_listpool._list[dstIdx].prevIdx;
-            _listpool._list[dstIdx].prevIdx=idx;
-            if(_listpool._list[idx].prevIdx!=-1)//not empty, middle
-                _listpool._list[_listpool._list[idx].prevIdx].nextIdx=idx;
-            else// //notempty, begin
-                _firstIdx=idx;
-        }else
-        {
-            // //notempty, begin
-            //notempty, end
-            if(_sz)
-            {
-                _listpool._list[idx].prevIdx=_lastIdx;
-                _lastIdx=idx;
-                _listpool._list[_listpool._list[idx].prevIdx].nextIdx=idx;
-            }
-            //empty, begin/end
-            else
-            {
-                _listpool._list[idx].prevIdx=-1;
-                _lastIdx=idx;
-                _firstIdx=idx;
-            }
-        }
-
-        _sz++;
-
-        new(&_listpool._list[idx].buf) value_type(uboost::forward<Args>(args)...);
-
-        return position--;
+        Idx idx=_listpool->claim();
+        if(idx==null_idx)
+            return end();
+        new(&_listpool->_items.slot(idx).buf) value_type(uboost::forward<Args>(args)...);
+        link(position.idx, idx);
+        return iterator(this, idx);
     };
 
 
@@ -622,30 +1032,26 @@ class list
         return emplace(position, val);
     };
 
+    // n items are claimed and linked as one chain
     iterator insert (const_iterator position, size_type n, const value_type& val)
     {
-        iterator it=position;
-        for(int i=0;i<n;i++)
-            it=emplace(position, val);
-        return it;
+        return iterator(this, emplace_n(position.idx, n, val));
     };
 
     template <class InputIterator>
-      iterator insert (const_iterator position, InputIterator first, InputIterator last)
+      typename enable_if<!is_integral<InputIterator>::value, iterator>::type
+      insert (const_iterator position, InputIterator first, InputIterator last)
     {
-        iterator ptr=end();
-        for(InputIterator it=first;
+        if(first==last)
+            return iterator(this, position.idx);
+        iterator ret=emplace(position, *first);
+        for(InputIterator it=++first;
             it!=last ;
             it++)
         {
-            if(ptr.end)
-                ptr=emplace(position,it);
-            else
-                emplace(position,it);
+            emplace(position, *it);
         }
-        if(ptr.end)
-        return position;
-        else return ptr;
+        return ret;
     };
 
     iterator insert (const_iterator position, value_type&& val)
@@ -656,132 +1062,183 @@ class list
     //iterator insert (const_iterator position, initializer_list<value_type> il);
 
     private:
-    void cut(const_iterator position)
-    {
-        uint16_t idx=position.idx;
-        if(idx!=-1)
-        {
-            if(_listpool[idx].nextIdx!=-1)
-                 //notempty,middle
-                _listpool[_listpool[idx].nextIdx].prevIdx=_listpool[idx].prevIdx;
-            else //notempty, prior to end
-                _lastIdx=_listpool[idx].prevIdx;
-            if(_listpool[idx].prevIdx!=-1)
-                 //notempty, middle
-                _listpool[_listpool[idx].prevIdx].nextIdx=_listpool[idx].nextIdx;
-            else //notempty, begin
-                _firstIdx=_listpool[idx].nextIdx;
-            _sz--;
-        }else //empty begin/end, notempty end
-            ;//return end();
+    // links of item idx, null_idx being the sentinel(list head)
+    Idx next_of(Idx idx) const
+    {
+        return (idx!=null_idx)?_listpool->_items.link(idx).nextIdx:_firstIdx;
+    };
+
+    Idx prev_of(Idx idx) const
+    {
+        return (idx!=null_idx)?_listpool->_items.link(idx).prevIdx:_lastIdx;
+    };
+
+    void set_next(Idx idx, Idx next)
+    {
+        _listpool->_version++;
+        if(idx!=null_idx)
+            _listpool->_items.link(idx).nextIdx=next;
+        else
+            _firstIdx=next;
+    };
+
+    void set_prev(Idx idx, Idx prev)
+    {
+        _listpool->_version++;
+        if(idx!=null_idx)
+            _listpool->_items.link(idx).prevIdx=prev;
+        else
+            _lastIdx=prev;
+    };
+
+    // link n items chained from first to last right before dstIdx
+    void link_chain(Idx dstIdx, Idx first, Idx last, Idx n)
+    {
+        storage_type items=_listpool->_items;
+        Idx prevIdx=prev_of(dstIdx);
+        items.link(first).prevIdx=prevIdx;
+        items.link(last).nextIdx=dstIdx;
+        set_next(prevIdx, first);
+        set_prev(dstIdx, last);
+        _sz+=n;
+    };
+
+    // unlink n items chained from first to last, they keep their
+    // links between themselves
+    void cut_chain(Idx first, Idx last, Idx n)
+    {
+        storage_type items=_listpool->_items;
+        set_next(items.link(first).prevIdx, items.link(last).nextIdx);
+        set_prev(items.link(last).nextIdx, items.link(first).prevIdx);
+        _sz-=n;
+    };
+
+    // link free item idx right before dstIdx(null_idx means end)
+    void link(Idx dstIdx, Idx idx)
+    {
+        link_chain(dstIdx, idx, idx, 1);
+    };
+
+    // unlink item idx from this list, item is not returned to pool
+    void cut(Idx idx)
+    {
+        cut_chain(idx, idx, 1);
+    };
+
+    // destroy item idx and return it to pool
+    void erase_idx(Idx idx)
+    {
+        cut(idx);
+        _listpool->_items.slot(idx).get().~T();
+        _listpool->free(idx);
+    };
+
+    // claim n items as one chain, construct them from args and link them
+    // before dstIdx. Return first new item, dstIdx if nothing is inserted
+    template <class... Args>
+    Idx emplace_n(Idx dstIdx, size_type n, const Args&... args)
+    {
+        if(!n)
+            return dstIdx;
+        Idx last;
+        Idx first=_listpool->claim_chain(n, last);
+        if(first==null_idx)
+            return dstIdx;
+        storage_type items=_listpool->_items;
+        for(Idx i=first;;i=items.link(i).nextIdx)
+        {
+            new(&items.slot(i).buf) value_type(args...);
+            if(i==last)
+                break;
+        }
+        link_chain(dstIdx, first, last, n);
+        return first;
+    };
+
+    // number of items from first up to(not including) last
+    size_type count(Idx first, Idx last) const
+    {
+        size_type n=0;
+        for(;first!=last;first=next_of(first))
+            n++;
+        return n;
     };
 
     public:
     iterator erase (const_iterator position)
     {
-        if(position.idx==-1)
+        if(position.idx==null_idx)
           return end();
 
-        cut(position);
+        position.check();
+        Idx next=next_of(position.idx);
+        erase_idx(position.idx);
 
-        uint16_t idx=position.idx;
-        position++;
-        ( (T*)_listpool->_list[idx].buf)->~T();
-        _listpool->free(idx);
-
-        return position;
+        return iterator(this, next);
     }
 
+    // range is unlinked and returned to pool in one splice, items are
+    // only walked to destroy and count them
     iterator erase (const_iterator first, const_iterator last)
     {
-        const_iterator it=first;
-        while(it!=last)
+        if(first==last)
+            return iterator(this, last.idx);
+        first.check();
+
+        storage_type items=_listpool->_items;
+        Idx lastIdx=prev_of(last.idx);
+        size_type n=0;
+        for(Idx i=first.idx;i!=last.idx;i=items.link(i).nextIdx)
         {
-            it=erase(it);
-        };
-        return it;
+            items.slot(i).get().~T();
+            n++;
+        }
+        cut_chain(first.idx, lastIdx, n);
+        _listpool->free_chain(first.idx, lastIdx, n);
+        return iterator(this, last.idx);
     };
 
     //TODO: support this
     //void swap (list& x)
     //{
-    //    assert(false);
+    //    UBOOST_ASSERT(false);
     //}
 
+    // grows by one claimed chain, shrinks by one range erase starting
+    // from the nearer end
     void resize (size_type n)
     {
         if(n>_sz)
-        {
-            while(n++<_sz)
-                emplace_back();
-        }else
-        {
-            const_iterator it=cend()-(_sz-n);
-            erase(it, cend());
-        }
+            emplace_n(null_idx, n-_sz);
+        else if(n<_sz)
+            erase(iterator(this, nth(n)), end());
     };
 
     void resize (size_type n, const value_type& val)
     {
         if(n>_sz)
-        {
-            while(n++<_sz)
-                push_back(val);
-        }else
-        {
-            iterator it=end()-(_sz-n);
-            erase(it, end());
-        }
+            emplace_n(null_idx, n-_sz, val);
+        else if(n<_sz)
+            erase(iterator(this, nth(n)), end());
     }
 
     void clear()
     {
-        resize(0);
+        erase(begin(), end());
     }
 
+    // both list should share same listpool
     void splice (const_iterator position, list& x)
     //void splice (const_iterator position, list&& x);
     {
-        uint16_t dstIdx=position.get_idx();//can be -1(empty) or -1(end)
-        if(!x._sz)return; // do nothing if source x is empty
-
-        _listpool._list[x._lastIdx].nextIdx=dstIdx;
+        UBOOST_ASSERT(_listpool==x._listpool);
+        if(!x._sz || &x==this)return; // do nothing if source x is empty
 
-        if(dstIdx!=-1)
-        {
-            //this this list not empty and not end
-            _listpool._list[dstIdx].prevIdx=x._lastIdx;
-
-            //position is not first
-            if(_listpool._list[dstIdx].prevIdx!=-1)
-            {
-                _listpool._list[_listpool._list[dstIdx].prevIdx].nextIdx=x._firstIdx;
-                _listpool._list[x._firstIdx].prevIdx=_listpool._list[_listpool._list[dstIdx].prevIdx];
-            }
-            else
-                _firstIdx=x._firstIdx;
-        }else
-        {
-
-            //not empty, end
-            if(_sz)
-            {
-                _listpool._list[_lastIdx].nextIdx=x._firstIdx;
-                _listpool._list[x.firstIdx].prevIdx=_lastIdx;
-                _lastIdx=x._lastIdx;
-            }
-            //empty, begin/end
-            else
-            {
-                _firstIdx=x.firstIdx;
-                _lastIdx=x.lastIdx;
-            }
-        }
-        _sz+=x._sz;
+        link_chain(position.idx, x._firstIdx, x._lastIdx, x._sz);
 
         //leave clear state to the source list:
-        x._firstIdx=-1;
-        x._lastIdx=-1;
+        x._firstIdx=null_idx;
+        x._lastIdx=null_idx;
         x._sz=0;
     };
 
@@ -789,117 +1246,321 @@ class list
     void splice (const_iterator position, list& x, const_iterator i)
     //void splice (const_iterator position, list&& x, const_iterator i);
     {
-        //TODO: the logic is similiar with emplace.
-        //we should manage to share the code somehow
-        uint16_t dstIdx=position.get_idx();
+        UBOOST_ASSERT(_listpool==x._listpool);
+        Idx idx=i.idx;
+
+        if(idx==null_idx || idx==position.idx)return;
+        x.cut(idx);
+        link(position.idx, idx);
+    };
+
+    // range is moved in one relink, it is only walked to count it when
+    // moved between different lists. position should not be in the range
+    void splice (const_iterator position, list& x,
+                 const_iterator first, const_iterator last)
+    {
+        UBOOST_ASSERT(_listpool==x._listpool);
+        if(first==last)return;
 
-        uint16_t idx=i.get_idx;
+        Idx lastIdx=x.prev_of(last.idx);
+        size_type n=(&x==this)?0:x.count(first.idx, last.idx);
+        x.cut_chain(first.idx, lastIdx, n);
+        link_chain(position.idx, first.idx, lastIdx, n);
+    }
 
-        if(idx==-1)return;
-        x.cut(i);
+   // void splice (const_iterator position, list&& x,
+   //              const_iterator first, const_iterator last);
 
-        _listpool._list[idx].nextIdx=dstIdx;
+    // below algorithms only rewrite item links, contained objects are
+    // never moved or copied so non-movable T works as well
 
-        if(dstIdx!=-1)
-        {
-            _listpool._list[idx].prevIdx=_listpool._list[dstIdx].prevIdx;
-            _listpool._list[dstIdx].prevIdx=idx;
-            if(_listpool._list[idx].prevIdx!=-1)//not empty, middle
-                _listpool._list[_listpool._list[idx].prevIdx].nextIdx=idx;
-            else// //notempty, begin
-                _firstIdx=idx;
-        }else
+    // both list should be sorted and share same listpool, items of x are
+    // relinked into this list keeping order of equal items(this list first)
+    template <class Compare>
+      void merge (list& x, Compare comp)
+    {
+        UBOOST_ASSERT(_listpool==x._listpool);
+        if(&x==this || !x._sz)
+            return;
+
+        storage_type items=_listpool->_items;
+        Idx i=_firstIdx;
+        Idx j=x._firstIdx;
+        size_type rest=x._sz;
+        while(j!=null_idx)
         {
-            // //notempty, begin
-            //notempty, end
-            if(_sz)
+            if(i==null_idx)
             {
-                _listpool._list[idx].prevIdx=_lastIdx;
-                _lastIdx=idx;
-                _listpool._list[_listpool._list[idx].prevIdx].nextIdx=idx;
+                // remaining items of x go to the end in one chain
+                link_chain(null_idx, j, x._lastIdx, rest);
+                break;
             }
-            //empty, begin/end
-            else
+            if(comp(items.slot(j).get(), items.slot(i).get()))
             {
-                _listpool._list[idx].prevIdx=-1;
-                _lastIdx=idx;
-                _firstIdx=idx;
-            }
+                Idx next=items.link(j).nextIdx;
+                link(i, j);
+                rest--;
+                j=next;
+            }else
+                i=items.link(i).nextIdx;
         }
 
-        _sz++;
+        x._firstIdx=null_idx;
+        x._lastIdx=null_idx;
+        x._sz=0;
+    };
 
+    template <class Compare>
+      void merge (list&& x, Compare comp)
+    {
+        merge(x, comp);
     };
 
-    void splice (const_iterator position, list& x,
-                 const_iterator first, const_iterator last)
+    void merge (list& x)
+    {
+        merge(x, less<T>());
+    };
+
+    void merge (list&& x)
+    {
+        merge(x, less<T>());
+    };
+
+    // stable bottom-up merge sort over nextIdx links with O(1) extra
+    // space, prevIdx links are rebuilt in one pass afterward
+    template <class Compare>
+      void sort (Compare comp)
     {
-        const_iterator it=first;
-        while(it!=last)
+        if(_sz<2)
+            return;
+
+        _listpool->_version++;
+        storage_type items=_listpool->_items;
+        Idx head=_firstIdx;
+        Idx tail=null_idx;
+        // runs of width items are merged pairwise until one run is left,
+        // width never overflows as it is only doubled while 2*width<size
+        for(size_type width=1;;width*=2)
         {
-            const_iterator next_it=it++;
-            splice(position--, x, it);
-            it=next_it;
-        };
-    }
+            Idx p=head;
+            size_type merges=0;
+            head=null_idx;
+            tail=null_idx;
+            while(p!=null_idx)
+            {
+                merges++;
+                Idx q=p;
+                size_type psize=0;
+                while(psize<width && q!=null_idx)
+                {
+                    psize++;
+                    q=items.link(q).nextIdx;
+                }
+                size_type qsize=width;
+                while(psize || (qsize && q!=null_idx))
+                {
+                    Idx e;
+                    if(!psize)
+                    {
+                        e=q;
+                        q=items.link(q).nextIdx;
+                        qsize--;
+                    }else if(!qsize || q==null_idx ||
+                             !comp(items.slot(q).get(), items.slot(p).get()))
+                    {
+                        e=p;
+                        p=items.link(p).nextIdx;
+                        psize--;
+                    }else
+                    {
+                        e=q;
+                        q=items.link(q).nextIdx;
+                        qsize--;
+                    }
+                    if(tail!=null_idx)
+                        items.link(tail).nextIdx=e;
+                    else
+                        head=e;
+                    tail=e;
+                }
+                p=q;
+            }
+            items.link(tail).nextIdx=null_idx;
+            if(merges<=1)
+                break;
+        }
 
-   // void splice (const_iterator position, list&& x,
-   //              const_iterator first, const_iterator last);
+        Idx prev=null_idx;
+        for(Idx i=head;i!=null_idx;i=items.link(i).nextIdx)
+        {
+            items.link(i).prevIdx=prev;
+            prev=i;
+        }
+        _firstIdx=head;
+        _lastIdx=tail;
+    };
 
-  void merge (list& x);
-  void merge (list&& x);
-  template <class Compare>
-    void merge (list& x, Compare comp);
-  template <class Compare>
-    void merge (list&& x, Compare comp);
+    void sort()
+    {
+        sort(less<T>());
+    };
+
+    // swap links of every item
+    void reverse()
+    {
+        _listpool->_version++;
+        storage_type items=_listpool->_items;
+        for(Idx i=_firstIdx;i!=null_idx;)
+        {
+            Idx next=items.link(i).nextIdx;
+            items.link(i).nextIdx=items.link(i).prevIdx;
+            items.link(i).prevIdx=next;
+            i=next;
+        }
+        Idx first=_firstIdx;
+        _firstIdx=_lastIdx;
+        _lastIdx=first;
+    };
 
-  //TODO: support these algo-modification
-  //void sort();
-  //template <class Compare>
-  //  void sort (Compare comp);
+    template <class Predicate>
+      void remove_if (Predicate pred)
+    {
+        storage_type items=_listpool->_items;
+        for(Idx i=_firstIdx;i!=null_idx;)
+        {
+            Idx next=items.link(i).nextIdx;
+            if(pred(items.slot(i).get()))
+                erase_idx(i);
+            i=next;
+        }
+    };
 
-  //void reverse();
+    // val may be an item of this list, that one is erased last
+    void remove (const value_type& val)
+    {
+        storage_type items=_listpool->_items;
+        Idx self=null_idx;
+        for(Idx i=_firstIdx;i!=null_idx;)
+        {
+            Idx next=items.link(i).nextIdx;
+            if(&items.slot(i).get()==&val)
+                self=i;
+            else if(items.slot(i).get()==val)
+                erase_idx(i);
+            i=next;
+        }
+        if(self!=null_idx)
+            erase_idx(self);
+    };
 
-  //void remove (const value_type& val);
-  //  template <class Predicate>
-  //    void remove_if (Predicate pred);
+    // erase items equal to the item kept before them
+    template <class BinaryPredicate>
+      void unique (BinaryPredicate binary_pred)
+    {
+        if(_sz<2)
+            return;
+        storage_type items=_listpool->_items;
+        Idx kept=_firstIdx;
+        for(Idx i=items.link(kept).nextIdx;i!=null_idx;)
+        {
+            Idx next=items.link(i).nextIdx;
+            if(binary_pred(items.slot(kept).get(), items.slot(i).get()))
+                erase_idx(i);
+            else
+                kept=i;
+            i=next;
+        }
+    };
 
-  //  void unique();
-  //  template <class BinaryPredicate>
-  //    void unique (BinaryPredicate binary_pred);
+    void unique()
+    {
+        unique(equal_to<T>());
+    };
 
   //TODO: support relational operators
 
   private:
-  listpool<T>* _listpool;
-  uint16_t _sz;
-  //uint16_t _cap;
-
-  // use index instead pointer, null is marked by Idx=MAX(uint16_t)
-  uint16_t _firstIdx;
-  uint16_t _lastIdx;
+  // index of item at position pos(pos<=size, size gives null_idx), walked
+  // from the nearer end
+  Idx nth(size_type pos) const
+  {
+      Idx idx;
+      if(pos<=_sz/2)
+      {
+          idx=_firstIdx;
+          for(size_type i=0;i<pos;i++)
+              idx=_listpool->_items.link(idx).nextIdx;
+      }else
+      {
+          idx=null_idx;
+          for(size_type i=_sz;i>pos;i--)
+              idx=prev_of(idx);
+      }
+      return idx;
+  };
+
+  friend class listpool<T, Idx, Layout>;
+
+  listpool<T, Idx, Layout>* _listpool;
+  Idx _sz;
+  //Idx _cap;
+
+  // links of list head(the sentinel), null is marked by Idx=MAX(Idx)
+  Idx _firstIdx;
+  Idx _lastIdx;
 };
 
 namespace declare
 {
 
-template <class T, uint16_t cap>
-class listpool:public uboost::listpool<T>
+/**
+ *  @brief declaration point of uboost::listpool, reserve space for cap
+ *  list items
+ *  @tparam T type of contained object
+ *  @tparam cap maximum number of list items
+ *  @tparam Idx unsigned type of item index, its maximum value is kept as
+ *  null link so uboost::index_type<cap+1>::type gives the narrowest one
+ *  @tparam Align alignment of the item array(of both arrays with
+ *  split_layout), pass uboost::cache_line_size to keep the pool off cache
+ *  lines shared with its neighbours
+ *  @tparam Layout uboost::interleaved_layout or uboost::split_layout,
+ *  lists using the pool should be declared with the same one(see
+ *  list_type)
+ */
+template <class T, uint64_t cap, class Idx=size_type, size_type Align=alignof(T),
+          class Layout=interleaved_layout>
+class listpool:public uboost::listpool<T, Idx, Layout>
 {
+    static_assert(cap<Idx(-1), "listpool capacity exceeds its index type, "
+                               "use index_type<cap+1>::type");
+
     public:
+    typedef typename uboost::listpool<T, Idx, Layout>::item_type item_type;
+
     listpool()
-    :uboost::listpool<T>(_buf, cap){};
+    :uboost::listpool<T, Idx, Layout>(_buf.get(), _occupied, cap){};
     listpool(const listpool&)=delete;
     listpool(listpool&&)=delete;
     listpool& operator=(const listpool&)=delete;
     listpool& operator=(listpool&&)=delete;
 
-    ~listpool();
+    ~listpool()
+    {
+    };
 
     private:
-    _internal::listitem<T> _buf[cap];
+    typename Layout::template buffer<T, Idx, cap, Align> _buf;
+    typename uboost::listpool<T, Idx, Layout>::bitmap_word
+        _occupied[cap?(cap+_internal::bitmap_word_bits-1)/_internal::bitmap_word_bits:1];
 };
 
+/**
+ *  @brief declare::listpool with uboost::split_layout, so the layout does
+ *  not need Idx and Align restated, e.g. declare::listpool_split<T, cap>
+ */
+template <class T, uint64_t cap, class Idx=size_type, size_type Align=alignof(T)>
+using listpool_split=listpool<T, cap, Idx, Align, split_layout>;
+
 };//namespace declare
 
 };//namespace boost
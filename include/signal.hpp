@@ -0,0 +1,276 @@
+/**@file signal.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 09:12:40 2026 okyfirmansyah
+ */
+
+#include "config.hpp"
+
+#ifndef UBOOST_SIGNAL_HPP_
+#define UBOOST_SIGNAL_HPP_
+
+#include "uboost.hpp"
+
+namespace uboost
+{
+
+/**
+ *  @brief handle returned by uboost::signal::connect(), used to
+ *  disconnect the slot later. Default constructed handle(or the one
+ *  returned by connect() on full signal) is not connected to any slot
+ */
+struct signal_connection
+{
+	signal_connection()
+	:id(0){};
+
+	explicit signal_connection(uint16_t _id)
+	:id(_id){};
+
+	bool valid() const
+	{
+		return id!=0;
+	};
+
+	uint16_t id;
+};
+
+template <typename Sig,
+          size_type InlineBytes=_internal::default_function_inline_bytes>
+class signal;
+
+/**
+ *  @brief multicast dispatcher calling every connected slot on emit()
+ *
+ *  Slots are uboost::function objects kept in a contiguous array declared
+ *  by uboost::declare::signal, so emit() is a linear walk calling each
+ *  slot invoker directly, without any allocation. Like uboost::vector,
+ *  this class is used to pass signal reference around while
+ *  uboost::declare::signal is the declaration point.
+ *
+ *  Slots are called in connection order. Slot may connect or disconnect
+ *  any slot(including itself) while signal is emitting: disconnected slot
+ *  is only marked and skipped, then removed once outermost emit()
+ *  returns, and newly connected slot is first called on next emit().
+ *
+ *  @tparam TArgs type list of arguments
+ *  @tparam InlineBytes space reserved for each slot callable object
+ */
+template <typename... TArgs, size_type InlineBytes>
+class signal<void (TArgs...), InlineBytes>
+{
+	public:
+	typedef function<void (TArgs...), InlineBytes> slot_type;
+	typedef signal_connection connection;
+
+	protected:
+	struct slot
+	{
+		template <typename fun>
+		slot(fun&& _fun, uint16_t _id)
+		:fn(forward<fun>(_fun)),id(_id){};
+
+		slot_type fn;
+		// zero marks slot disconnected during emit
+		uint16_t id;
+	};
+
+	explicit signal(slot* __slots, size_type __cap)
+	:_slots(__slots),_cap(__cap),_sz(0),_lastId(0),_emitting(0),_pending(false),_wrapped(false)
+	{};
+
+	~signal()
+	{
+		disconnect_all();
+	};
+
+	public:
+	signal()=delete;
+	signal(const signal&)=delete;
+	signal(signal&&)=delete;
+	signal& operator=(const signal&)=delete;
+	signal& operator=(signal&&)=delete;
+
+	//size
+	size_type size() const
+	{
+		return _sz;
+	};
+
+	//max_size
+	size_type max_size() const
+	{
+		return _cap;
+	};
+
+	//empty
+	bool empty() const
+	{
+		return (_sz==0);
+	};
+
+	// return invalid connection if there is no free slot
+	template <typename fun>
+	connection connect(fun&& _fun)
+	{
+		if(_sz>=_cap)
+		{
+			UBOOST_ASSERT(false);
+			return connection();
+		}
+		next_id();
+		new(&_slots[_sz++]) slot(forward<fun>(_fun), _lastId);
+		return connection(_lastId);
+	};
+
+	// bind member function to object
+	template <typename T, typename M, typename C>
+	connection connect(T& obj, M C::* pmf)
+	{
+		return connect(slot_type(obj, pmf));
+	};
+
+	bool connected(connection c) const
+	{
+		return c.valid() && find(c.id)!=_sz;
+	};
+
+	void disconnect(connection& c)
+	{
+		size_type i=find(c.id);
+		c=connection();
+		if(i==_sz)
+			return;
+		_slots[i].id=0;
+		_pending=true;
+		if(!_emitting)
+			compact();
+	};
+
+	void disconnect_all()
+	{
+		for(size_type i=0;i<_sz;i++)
+			_slots[i].id=0;
+		_pending=true;
+		if(!_emitting)
+			compact();
+	};
+
+	void emit(TArgs... args)
+	{
+		// slot connected during this emit is not called
+		size_type n=_sz;
+		_emitting++;
+		for(size_type i=0;i<n;i++)
+		{
+			if(_slots[i].id)
+				_slots[i].fn(args...);
+		}
+		if(!--_emitting && _pending)
+			compact();
+	};
+
+	void operator()(TArgs... args)
+	{
+		emit(args...);
+	};
+
+	private:
+	// once ids wrapped around, skip the ones still used by connected
+	// slots(there are less than _cap of them) so no two slots share one
+	void next_id()
+	{
+		do
+		{
+			if(!++_lastId)
+			{
+				_wrapped=true;
+				++_lastId;
+			}
+		}while(_wrapped && find(_lastId)!=_sz);
+	};
+
+	size_type find(uint16_t id) const
+	{
+		size_type i=0;
+		if(id)
+			while(i<_sz && _slots[i].id!=id)
+				i++;
+		else
+			i=_sz;
+		return i;
+	};
+
+	// remove disconnected slots while keeping connection order
+	void compact()
+	{
+		size_type w=0;
+		for(size_type r=0;r<_sz;r++)
+		{
+			if(!_slots[r].id)
+				continue;
+			if(w!=r)
+			{
+				_slots[w].fn=move(_slots[r].fn);
+				_slots[w].id=_slots[r].id;
+			}
+			w++;
+		}
+		for(size_type i=w;i<_sz;i++)
+			_slots[i].~slot();
+		_sz=w;
+		_pending=false;
+	};
+
+	slot* _slots;
+	size_type _cap;
+	size_type _sz;
+	uint16_t _lastId;
+	uint8_t _emitting;
+	bool _pending;
+	bool _wrapped;
+};
+
+namespace declare
+{
+
+/**
+ *  @brief declaration point of uboost::signal, reserve space for
+ *  Capacity slots
+ *  @tparam Sig signature of slot(should return void)
+ *  @tparam Capacity maximum number of connected slots
+ *  @tparam InlineBytes space reserved for each slot callable object
+ */
+template <typename Sig, size_type Capacity,
+          size_type InlineBytes=_internal::default_function_inline_bytes>
+class signal:public uboost::signal<Sig, InlineBytes>
+{
+	typedef uboost::signal<Sig, InlineBytes> base;
+	typedef typename base::slot slot;
+
+	public:
+	signal()
+	:base(reinterpret_cast<slot*>(_buf.buf), Capacity){};
+
+	signal(const signal&)=delete;
+	signal(signal&&)=delete;
+	signal& operator=(const signal&)=delete;
+	signal& operator=(signal&&)=delete;
+
+	private:
+	_internal::function_storage<sizeof(slot)*Capacity> _buf;
+};
+
+};//namespace declare
+
+};//namespace uboost
+
+#endif /* UBOOST_SIGNAL_HPP_ */
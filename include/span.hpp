@@ -0,0 +1,298 @@
+/**@file span.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * Non-owning view over contiguous elements(uboost::vector, C array or
+ * pointer/length pair), modeled after C++20 std::span. Dynamic extent
+ * span is a pointer and a size, fixed extent span is only a pointer.
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 19:10:26 2026 okyfirmansyah
+ */
+
+#include "config.hpp"
+
+#ifndef UBOOST_SPAN_HPP_
+#define UBOOST_SPAN_HPP_
+
+#include "uboost.hpp"
+#include "iterator.hpp"
+#include "vector.hpp"
+
+namespace uboost
+{
+
+/**
+ *  @brief extent of span whose size is only known at runtime
+ */
+const size_type dynamic_extent=size_type(-1);
+
+template <class T, size_type Extent=dynamic_extent>
+class span;
+
+namespace _internal
+{
+
+// size of fixed extent span is part of its type, so it takes no space
+template <size_type Extent>
+struct span_extent
+{
+	explicit span_extent(size_type n)
+	{
+		UBOOST_ASSERT(n==Extent);
+		(void)n;
+	};
+
+	size_type size() const
+	{
+		return Extent;
+	};
+};
+
+template <>
+struct span_extent<dynamic_extent>
+{
+	explicit span_extent(size_type n)
+	:_sz(n){};
+
+	size_type size() const
+	{
+		return _sz;
+	};
+
+	private:
+	size_type _sz;
+};
+
+// extent of span<T, Extent>.subspan<Offset, Count>()
+template <size_type Extent, size_type Offset, size_type Count>
+struct subspan_extent
+{
+	static const size_type value=(Count!=dynamic_extent)?Count:
+	                             ((Extent!=dynamic_extent)?Extent-Offset:dynamic_extent);
+};
+
+};//namespace _internal
+
+/**
+ *  @brief view over Extent(or runtime size if Extent is dynamic_extent)
+ *  contiguous elements, elements are not owned and should outlive the span
+ *  @tparam T element type, const T gives read only view
+ *  @tparam Extent number of elements, dynamic_extent if not known at
+ *  compile time
+ */
+template <class T, size_type Extent>
+class span:private _internal::span_extent<Extent>
+{
+	typedef _internal::span_extent<Extent> extent_type;
+
+	public:
+	typedef T element_type;
+	typedef typename remove_const<T>::type value_type;
+	typedef uboost::size_type size_type;
+	typedef uboost::ptrdiff_t difference_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef T* iterator;
+	typedef uboost::reverse_iterator<iterator> reverse_iterator;
+
+	static const size_type extent=Extent;
+
+	// constructors
+	span()
+	:extent_type(0),_data(nullptr)
+	{
+		static_assert(Extent==0 || Extent==dynamic_extent,
+		              "only empty or dynamic extent span is default constructible");
+	};
+
+	span(pointer __data, size_type __sz)
+	:extent_type(__sz),_data(__data){};
+
+	span(pointer first, pointer last)
+	:extent_type(size_type(last-first)),_data(first){};
+
+	template <size_type N>
+	span(element_type (&arr)[N])
+	:extent_type(N),_data(arr)
+	{
+		static_assert(Extent==dynamic_extent || N==Extent,
+		              "array size differs from span extent");
+	};
+
+	template <class S>
+	span(vector<value_type, S>& v)
+	:extent_type(v.size()),_data(v.data()){};
+
+	// only for span of const elements
+	template <class S, class TT=T,
+	          class=typename enable_if<!is_same<TT, value_type>::value>::type>
+	span(const vector<value_type, S>& v)
+	:extent_type(v.size()),_data(v.data()){};
+
+	// span<T> to span<const T>, fixed to dynamic extent(or dynamic to
+	// fixed one, checked by assert)
+	template <class U, size_type N,
+	          class=typename enable_if<(is_same<T, U>::value || is_same<T, const U>::value) &&
+	                                   (Extent==dynamic_extent || N==dynamic_extent || N==Extent)>::type>
+	span(const span<U, N>& s)
+	:extent_type(s.size()),_data(s.data()){};
+
+	//size
+	size_type size() const
+	{
+		return extent_type::size();
+	};
+
+	size_type size_bytes() const
+	{
+		return size()*sizeof(T);
+	};
+
+	//empty
+	bool empty() const
+	{
+		return size()==0;
+	};
+
+	//data
+	pointer data() const
+	{
+		return _data;
+	};
+
+	//element access operator
+	reference operator[](size_type n) const
+	{
+		UBOOST_ASSERT(n<size());
+		return _data[n];
+	};
+
+	//front
+	reference front() const
+	{
+		UBOOST_ASSERT(!empty());
+		return _data[0];
+	};
+
+	//back
+	reference back() const
+	{
+		UBOOST_ASSERT(!empty());
+		return _data[size()-1];
+	};
+
+	//iterators
+	iterator begin() const
+	{
+		return _data;
+	};
+
+	iterator end() const
+	{
+		return _data+size();
+	};
+
+	reverse_iterator rbegin() const
+	{
+		return reverse_iterator(end());
+	};
+
+	reverse_iterator rend() const
+	{
+		return reverse_iterator(begin());
+	};
+
+	//first
+	span<T> first(size_type n) const
+	{
+		UBOOST_ASSERT(n<=size());
+		return span<T>(_data, n);
+	};
+
+	template <size_type N>
+	span<T, N> first() const
+	{
+		static_assert(Extent==dynamic_extent || N<=Extent, "span is shorter than N");
+		UBOOST_ASSERT(N<=size());
+		return span<T, N>(_data, N);
+	};
+
+	//last
+	span<T> last(size_type n) const
+	{
+		UBOOST_ASSERT(n<=size());
+		return span<T>(_data+size()-n, n);
+	};
+
+	template <size_type N>
+	span<T, N> last() const
+	{
+		static_assert(Extent==dynamic_extent || N<=Extent, "span is shorter than N");
+		UBOOST_ASSERT(N<=size());
+		return span<T, N>(_data+size()-N, N);
+	};
+
+	//subspan, count defaults to the rest of span
+	span<T> subspan(size_type offset, size_type count=dynamic_extent) const
+	{
+		UBOOST_ASSERT(offset<=size());
+		if(count==dynamic_extent)
+			count=size()-offset;
+		UBOOST_ASSERT(count<=size()-offset);
+		return span<T>(_data+offset, count);
+	};
+
+	template <size_type Offset, size_type Count=dynamic_extent>
+	span<T, _internal::subspan_extent<Extent, Offset, Count>::value> subspan() const
+	{
+		static_assert(Extent==dynamic_extent || Offset<=Extent, "span is shorter than offset");
+		static_assert(Extent==dynamic_extent || Count==dynamic_extent || Count<=Extent-Offset,
+		              "span is shorter than offset+count");
+		UBOOST_ASSERT(Offset<=size());
+		return span<T, _internal::subspan_extent<Extent, Offset, Count>::value>(
+		           _data+Offset, (Count!=dynamic_extent)?Count:size()-Offset);
+	};
+
+	private:
+	pointer _data;
+};
+
+/**
+ *  @brief span helpers, since class template arguments can not be deduced
+ */
+template <class T>
+span<T> make_span(T* data, size_type n)
+{
+	return span<T>(data, n);
+}
+
+template <class T, size_type N>
+span<T, N> make_span(T (&arr)[N])
+{
+	return span<T, N>(arr);
+}
+
+template <class T, class S>
+span<T> make_span(vector<T, S>& v)
+{
+	return span<T>(v);
+}
+
+template <class T, class S>
+span<const T> make_span(const vector<T, S>& v)
+{
+	return span<const T>(v);
+}
+
+};//namespace uboost
+
+#endif /* UBOOST_SPAN_HPP_ */
@@ -0,0 +1,257 @@
+/**@file task_ring.hpp
+ *
+ * This is part of uboost, a lightweight tools/helper functions and classes
+ * implementation that supposed  to help bring c++11 feature/experience to
+ * embedded software development. This library is an implementation
+ * subset/streamlined version of c+11 boost/std library so to fit and
+ * compatible with embedded compiler/environment(given the compiler front-end
+ * compliance with c++11 specification).
+ *
+ * @author Oky Firmansyah <mail@okyfirmansyah.net>.
+ *
+ * @date Created      : Fri Oct 16 13:40:05 2026 okyfirmansyah
+ */
+
+#include "config.hpp"
+
+#ifndef UBOOST_TASK_RING_HPP_
+#define UBOOST_TASK_RING_HPP_
+
+#include "uboost.hpp"
+
+namespace uboost
+{
+
+template <typename Sig>
+class task_ring;
+
+/**
+ *  @brief FIFO queue of deferred callable objects packed in a byte ring
+ *
+ *  Unlike a queue of uboost::function, every task only takes a record
+ *  header(invoker, manager and record size) plus the exact size of its
+ *  callable object, so small lambdas are packed densely. Record is never
+ *  split: if it doesnt fit the end of the ring, the ring wraps and the
+ *  record is placed at the beginning. Like uboost::vector, this class is
+ *  used to pass ring reference around while uboost::declare::task_ring is
+ *  the declaration point.
+ *
+ *  Task callable object only needs to be movable. It is invoked and then
+ *  destroyed in place by pop_invoke(), and task may push new tasks while
+ *  it is running.
+ *
+ *  @tparam TArgs type list of arguments passed to each task
+ */
+template <typename... TArgs>
+class task_ring<void (TArgs...)>
+{
+	public:
+	// required by functionHandle
+	typedef void ResultType;
+	static const bool copyable=false;
+
+	typedef void (*invoker_type)(void*, TArgs...);
+	typedef bool (*manager_type)(_internal::function_op, void*, void*);
+
+	private:
+	typedef _internal::function_storage<sizeof(void*)> align_type;
+	static const size_type record_align=alignof(align_type);
+
+	struct record
+	{
+		invoker_type invoker;
+		// nullptr if callable object is trivially copyable
+		// (functionHandle::trivial), its destruction is skipped then
+		manager_type manager;
+		// whole record size including header
+		size_type size;
+	};
+
+	static size_type aligned(size_type n)
+	{
+		return (n+record_align-1)/record_align*record_align;
+	};
+
+	static const size_type header_size=(sizeof(record)+record_align-1)/record_align*record_align;
+
+	protected:
+	explicit task_ring(uint8_t* __buf, size_type __cap)
+	:_buf(__buf),_cap(__cap),_head(0),_tail(0),_mark(__cap),_sz(0),_wrapped(false)
+	{};
+
+	~task_ring()
+	{
+		clear();
+	};
+
+	public:
+	task_ring()=delete;
+	task_ring(const task_ring&)=delete;
+	task_ring(task_ring&&)=delete;
+	task_ring& operator=(const task_ring&)=delete;
+	task_ring& operator=(task_ring&&)=delete;
+
+	//size, in number of tasks
+	size_type size() const
+	{
+		return _sz;
+	};
+
+	//empty
+	bool empty() const
+	{
+		return (_sz==0);
+	};
+
+	//capacity, in bytes
+	size_type capacity() const
+	{
+		return _cap;
+	};
+
+	// number of bytes needed to push callable object of type fun
+	template <typename fun>
+	static size_type record_size()
+	{
+		return header_size+aligned(sizeof(typename decay<fun>::type));
+	};
+
+	// return false if there is no contiguous space left for the task
+	template <typename fun>
+	bool push(fun&& _fun)
+	{
+		typedef typename decay<fun>::type fun_type;
+		typedef _internal::functionHandle<task_ring, fun_type, false> handle_type;
+		static_assert(alignof(fun_type)<=record_align,
+		              "task callable object alignment is not supported");
+
+		size_type n=record_size<fun>();
+		uint8_t* p=reserve(n);
+		if(!p)
+			return false;
+
+		record* r=reinterpret_cast<record*>(p);
+		handle_type::create(p+header_size, forward<fun>(_fun), nullptr);
+		r->invoker=&handle_type::template invoke<TArgs...>;
+		r->manager=handle_type::trivial?nullptr:&handle_type::manage;
+		r->size=n;
+		_sz++;
+		return true;
+	};
+
+	// invoke oldest task and destroy it, return false if ring is empty
+	bool pop_invoke(TArgs... args)
+	{
+		if(!_sz)
+			return false;
+		uint8_t* p=_buf+_head;
+		record* r=reinterpret_cast<record*>(p);
+		r->invoker(p+header_size, forward<TArgs>(args)...);
+		release(r);
+		return true;
+	};
+
+	// invoke all tasks, including the ones pushed while invoking
+	void run(TArgs... args)
+	{
+		while(pop_invoke(args...));
+	};
+
+	// destroy all tasks without invoking them
+	void clear()
+	{
+		while(_sz)
+			release(reinterpret_cast<record*>(_buf+_head));
+	};
+
+	private:
+	uint8_t* reserve(size_type n)
+	{
+		if(!_sz)
+		{
+			_head=_tail=0;
+			_mark=_cap;
+			_wrapped=false;
+		}
+
+		if(!_wrapped)
+		{
+			// data is [head, tail), free space is [tail, cap) and [0, head)
+			if(_cap-_tail>=n)
+				return advance(n);
+			if(_head>=n)
+			{
+				_mark=_tail;
+				_tail=0;
+				_wrapped=true;
+				return advance(n);
+			}
+		}else if(_head-_tail>=n)
+		{
+			// data is [head, mark) and [0, tail), free space is [tail, head)
+			return advance(n);
+		}
+		return nullptr;
+	};
+
+	uint8_t* advance(size_type n)
+	{
+		uint8_t* p=_buf+_tail;
+		_tail+=n;
+		return p;
+	};
+
+	void release(record* r)
+	{
+		if(r->manager)
+			r->manager(_internal::function_op_destroy,
+			           reinterpret_cast<uint8_t*>(r)+header_size, nullptr);
+		_head+=r->size;
+		if(_wrapped && _head==_mark)
+		{
+			_head=0;
+			_mark=_cap;
+			_wrapped=false;
+		}
+		_sz--;
+	};
+
+	uint8_t* _buf;
+	size_type _cap;
+	size_type _head;
+	size_type _tail;
+	size_type _mark;
+	size_type _sz;
+	bool _wrapped;
+};
+
+namespace declare
+{
+
+/**
+ *  @brief declaration point of uboost::task_ring, reserve Bytes
+ *  of ring space
+ *  @tparam Sig signature of task(should return void)
+ *  @tparam Bytes ring space, shared by record headers and callable objects
+ */
+template <typename Sig, size_type Bytes>
+class task_ring:public uboost::task_ring<Sig>
+{
+	public:
+	task_ring()
+	:uboost::task_ring<Sig>(_buf.buf, Bytes){};
+
+	task_ring(const task_ring&)=delete;
+	task_ring(task_ring&&)=delete;
+	task_ring& operator=(const task_ring&)=delete;
+	task_ring& operator=(task_ring&&)=delete;
+
+	private:
+	_internal::function_storage<Bytes> _buf;
+};
+
+};//namespace declare
+
+};//namespace uboost
+
+#endif /* UBOOST_TASK_RING_HPP_ */
@@ -18,17 +18,85 @@
 #ifndef UBOOST_HPP_
 #define UBOOST_HPP_
 
+#include <string.h>
+
+
+/**
+ * UBOOST_ASSERT(cond) reports violated precondition to check handler,
+ * UBOOST_CHECK(cond) does the same but also yields cond so the caller can
+ * skip the offending operation when handler returns. Both compile to
+ * nothing(UBOOST_CHECK to true) in UBOOST_CHECK_UNCHECKED mode, so cond
+ * should never have side effects.
+ */
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_UNCHECKED
+#define UBOOST_ASSERT(cond) ((void)0)
+#define UBOOST_CHECK(cond) true
+#else
+#define UBOOST_ASSERT(cond) ((cond)?(void)0:uboost::check_failed(__FILE__, __LINE__))
+#define UBOOST_CHECK(cond) ((cond)?true:(uboost::check_failed(__FILE__, __LINE__), false))
+#endif
 
 namespace uboost
 {
 
-void assert(bool cond)
+/**
+ *  @brief called on violated check with its source location. Handler may
+ *  stop the program(default one traps) or report and return, in that case
+ *  the offending access/insertion is skipped where possible
+ */
+typedef void (*check_handler_type)(const char* file, int line);
+
+namespace _internal
+{
+
+inline void default_check_handler(const char*, int)
 {
+#if defined(__GNUC__)
+	__builtin_trap();
+#else
+	for(;;);
+#endif
+};
+
+inline check_handler_type& check_handler()
+{
+	static check_handler_type handler=&default_check_handler;
+	return handler;
+};
 
+};//namespace _internal
+
+// install new check handler, return the previous one
+inline check_handler_type set_check_handler(check_handler_type handler)
+{
+	check_handler_type old=_internal::check_handler();
+	_internal::check_handler()=handler?handler:&_internal::default_check_handler;
+	return old;
+};
+
+inline void check_failed(const char* file, int line)
+{
+	_internal::check_handler()(file, line);
 };
 
 
-typedef uint16_t size_type;
+/**
+ *  @brief default type of container size and index(see UBOOST_SIZE_TYPE)
+ */
+typedef UBOOST_SIZE_TYPE size_type;
+
+/**
+ *  @brief defines suitable integer type to contains
+ *  difference between two pointer of object
+ */
+typedef UBOOST_PTRDIFF_TYPE ptrdiff_t;
+
+/**
+ *  @brief cache line size of target(see UBOOST_CACHE_LINE_SIZE), pass it
+ *  as alignment of declare:: containers to keep them off cache lines
+ *  shared with neighbouring objects
+ */
+const size_type cache_line_size=UBOOST_CACHE_LINE_SIZE;
 
 /**
  * @brief compile-time branching metafunction
@@ -100,291 +168,666 @@ struct is_same<T,T>
 	static const bool value=true;
 };
 
-namespace _internal
+/**
+ *  @brief metafunction to remove top-level const qualifier
+ *  @tparam T class typename that can be const-qualified
+ */
+template <class T> struct remove_const         {typedef T type;};
+template <class T> struct remove_const<const T>{typedef T type;};
+
+/**
+ *  @brief metafunction to obtain the type used to store a by-value
+ *  copy of T(reference and const are removed, function type
+ *  decays to function pointer)
+ *  @tparam T class typename that can be any reference type
+ */
+template <class T>
+struct decay
 {
+	typedef typename remove_const<typename remove_reference<T>::type>::type type;
+};
+template <class R, class... TArgs>
+struct decay<R(TArgs...)>  {typedef R(*type)(TArgs...);};
+template <class R, class... TArgs>
+struct decay<R(&)(TArgs...)>{typedef R(*type)(TArgs...);};
 
 /**
- *  @brief change maximum_ptr_per_function_object to set
- *  maximum number of captured pointer in uboost::function()
- *  if USE_STATIC_ALLOCATION is used.
-*/
-const int maximum_ptr_per_function_object=3;
-const int maximum_functionhandle_overhead=sizeof(void*)*2;
-const int maximum_function_object_size_word=((maximum_ptr_per_function_object+1)*sizeof(void*)+
-                                             maximum_functionhandle_overhead)/4;
+ *  @brief compile-time overload filter(SFINAE helper)
+ *  @tparam B compile-time boolean expression to be check
+ *  @tparam T type definition in case B is true
+ */
+template<bool B, class T=void>
+struct enable_if {};
+template<class T>
+struct enable_if<true, T> { typedef T type; };
+
+/**
+ *  @brief metafunction to test whether T is an integer type(used to tell
+ *  (count, value) overloads from (first, last) iterator overloads)
+ *  @tparam T typename to be checked
+ */
+template <class T> struct is_integral                    {static const bool value=false;};
+template <class T> struct is_integral<const T>           {static const bool value=is_integral<T>::value;};
+template <> struct is_integral<bool>                     {static const bool value=true;};
+template <> struct is_integral<char>                     {static const bool value=true;};
+template <> struct is_integral<signed char>              {static const bool value=true;};
+template <> struct is_integral<unsigned char>            {static const bool value=true;};
+template <> struct is_integral<short>                    {static const bool value=true;};
+template <> struct is_integral<unsigned short>           {static const bool value=true;};
+template <> struct is_integral<int>                      {static const bool value=true;};
+template <> struct is_integral<unsigned int>             {static const bool value=true;};
+template <> struct is_integral<long>                     {static const bool value=true;};
+template <> struct is_integral<unsigned long>            {static const bool value=true;};
+template <> struct is_integral<long long>                {static const bool value=true;};
+template <> struct is_integral<unsigned long long>       {static const bool value=true;};
 
-// base clase for function implementation
-class functionImplBase
+/**
+ *  @brief metafunction to obtain the narrowest unsigned type able to
+ *  hold N, used as container index type chosen by capacity
+ *  @tparam N maximum value to be held
+ */
+template <uint64_t N>
+struct index_type
 {
-	public:
-#ifdef USE_STATIC_ALLOCATION
-	virtual functionImplBase* Clone(void* buffr)const=0;
-#else
-	virtual functionImplBase* Clone()const=0;
-#endif
+	typedef typename conditional<(N<=0xFFu), uint8_t,
+	        typename conditional<(N<=0xFFFFu), uint16_t,
+	        typename conditional<(N<=0xFFFFFFFFu), uint32_t,
+	                             uint64_t>::type>::type>::type type;
 };
 
-// Generalized functor filter class
-template <typename R,typename... TArgs>
-class functionImpl;
+/**
+ *  @brief metafunction to obtain signed counterpart of unsigned
+ *  integer type
+ *  @tparam T unsigned integer type
+ */
+template <class T> struct make_signed;
+template <> struct make_signed<uint8_t> {typedef int8_t type;};
+template <> struct make_signed<uint16_t>{typedef int16_t type;};
+template <> struct make_signed<uint32_t>{typedef int32_t type;};
+template <> struct make_signed<uint64_t>{typedef int64_t type;};
+
+/**
+ *  @brief metafunction to obtain signed type able to hold difference of
+ *  any two values of unsigned index type(next wider one), used as
+ *  difference type of container iterators
+ *  @tparam T unsigned integer type
+ */
+template <class T> struct make_difference;
+template <> struct make_difference<uint8_t> {typedef int16_t type;};
+template <> struct make_difference<uint16_t>{typedef int32_t type;};
+template <> struct make_difference<uint32_t>{typedef int64_t type;};
+template <> struct make_difference<uint64_t>{typedef int64_t type;};
 
-// functor filter class for 0 params
-template <typename R>
-class functionImpl<R>:public functionImplBase
+/**
+ *  @brief metafunction to test whether T can be copied or relocated
+ *  with plain memcpy()(relies on compiler intrinsic)
+ *  @tparam T class typename to be checked
+ */
+template <class T>
+struct is_trivially_copyable
 {
-	public:
-	typedef R ResultType;
-	typedef void* Parm1;
-	typedef void* Parm2;
-	typedef void* Parm3;
-	typedef void* Parm4;
-	typedef void* Parm5;
-	typedef void* Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()() = 0;
+#if defined(__clang__) || defined(_MSC_VER) || (defined(__GNUC__) && __GNUC__>=5)
+	static const bool value=__is_trivially_copyable(T);
+#else
+	static const bool value=__has_trivial_copy(T)&&__has_trivial_destructor(T);
+#endif
 };
 
-// functor filter class for 1 params
-template <typename R, typename T1>
-class functionImpl<R, T1>:public functionImplBase
+/**
+ *  @brief metafunction to test whether destructor of T does nothing,
+ *  so it can be skipped when T is dropped from a container
+ *  @tparam T class typename to be checked
+ */
+template <class T>
+struct is_trivially_destructible
+{
+#if defined(__clang__)
+	static const bool value=__is_trivially_destructible(T);
+#else
+	static const bool value=__has_trivial_destructor(T);
+#endif
+};
 
+/**
+ *  @brief comparison function objects, default ordering and equality
+ *  used by container algorithms(e.g. uboost::list::sort and unique)
+ */
+template <class T>
+struct less
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef void* Parm2;
-	typedef void* Parm3;
-	typedef void* Parm4;
-	typedef void* Parm5;
-	typedef void* Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1) = 0;
+	bool operator()(const T& a, const T& b) const
+	{
+		return a<b;
+	};
 };
 
-// functor filter class for 2 params
-template <typename R, typename T1, typename T2>
-class functionImpl<R, T1, T2>:public functionImplBase
+template <class T>
+struct equal_to
+{
+	bool operator()(const T& a, const T& b) const
+	{
+		return a==b;
+	};
+};
 
+/**
+ *  @brief fixed-block pool to hold callable objects that do not fit
+ *  uboost::function inline space.
+ *
+ *  Like uboost::listpool, this class only manages user-supplied space,
+ *  declaration of the space itself should be done through
+ *  uboost::declare::function_pool. Free blocks are chained as a singly
+ *  linked list through their first word so claim() and free() are O(1).
+ */
+class function_pool
 {
 	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef void* Parm3;
-	typedef void* Parm4;
-	typedef void* Parm5;
-	typedef void* Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1, Parm2) = 0;
+	function_pool(void* __buf, size_type __blockSz, size_type __cap)
+	:_head(nullptr),_blockSz(__blockSz),_cap(__cap),_sz(0)
+	{
+		// initialize free chain, lowest address first
+		uint8_t* block=static_cast<uint8_t*>(__buf)+__blockSz*__cap;
+		for(size_type i=0;i<__cap;i++)
+		{
+			block-=__blockSz;
+			*reinterpret_cast<void**>(block)=_head;
+			_head=block;
+		}
+	};
+
+	function_pool(const function_pool&)=delete;
+	function_pool(function_pool&&)=delete;
+	function_pool& operator=(const function_pool&)=delete;
+	function_pool& operator=(function_pool&&)=delete;
+
+	//free
+	size_type free() const
+	{
+		return _cap-_sz;
+	};
+
+	//size
+	size_type size() const
+	{
+		return _sz;
+	};
+
+	//max_size
+	size_type max_size() const
+	{
+		return _cap;
+	};
+
+	//block_size
+	size_type block_size() const
+	{
+		return _blockSz;
+	};
+
+	// return nullptr if pool is exhausted
+	void* claim()
+	{
+		void* block=_head;
+		if(block)
+		{
+			_head=*static_cast<void**>(block);
+			_sz++;
+		}
+		return block;
+	};
+
+	void free(void* block)
+	{
+		*static_cast<void**>(block)=_head;
+		_head=block;
+		_sz--;
+	};
+
+	private:
+	void* _head;
+	size_type _blockSz;
+	size_type _cap;
+	size_type _sz;
 };
 
-// functor filter class for 3 params
-template <typename R, typename T1, typename T2, typename T3>
-class functionImpl<R, T1, T2, T3>:public functionImplBase
+namespace declare
+{
+template <size_type BlockBytes, size_type Count>
+class function_pool;
+};//namespace declare
 
+namespace _internal
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef T3 Parm3;
-	typedef void* Parm4;
-	typedef void* Parm5;
-	typedef void* Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1, Parm2, Parm3) = 0;
-};
 
-// functor filter class for 4 params
-template <typename R, typename T1, typename T2, typename T3, typename T4>
-class functionImpl<R, T1, T2, T3, T4>:public functionImplBase
+/**
+ *  @brief change maximum_ptr_per_function_object to set
+ *  maximum number of captured pointer in uboost::function()
+ *  if USE_STATIC_ALLOCATION is used.
+*/
+const int maximum_ptr_per_function_object=3;
+const int maximum_functionhandle_overhead=sizeof(void*)*2;
+const int maximum_function_object_size_word=((maximum_ptr_per_function_object+1)*sizeof(void*)+
+                                             maximum_functionhandle_overhead)/4;
+
+/**
+ *  @brief default space(in bytes) reserved for the captured callable
+ *  object when no InlineBytes is given to uboost::function<>
+ */
+const size_type default_function_inline_bytes=maximum_function_object_size_word*4-
+                                              maximum_functionhandle_overhead;
 
+// raw storage with alignment suitable for any captured callable object
+template <size_type Bytes>
+union function_storage
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef T3 Parm3;
-	typedef T4 Parm4;
-	typedef void* Parm5;
-	typedef void* Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1, Parm2, Parm3, Parm4) = 0;
+	uint8_t buf[Bytes];
+	void* align_ptr;
+	void (*align_fptr)();
+	long long align_ll;
+	double align_d;
 };
 
-// functor filter class for 5 params
-template <typename R, typename T1, typename T2, typename T3, typename T4,
-typename T5>
-class functionImpl<R, T1, T2, T3, T4, T5>:public functionImplBase
+// operation requested to function manager
+enum function_op
+{
+	function_op_clone,
+	function_op_move,
+	function_op_destroy,
+};
 
+// check whether incoming function object to be wrapped is fit
+// with predetermined inline space of Parentfunctor
+template <class Parentfunctor, typename fun>
+struct function_fits
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef T3 Parm3;
-	typedef T4 Parm4;
-	typedef T5 Parm5;
-	typedef void* Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1, Parm2, Parm3, Parm4, Parm5) = 0;
+	static const bool value=(sizeof(fun)<=Parentfunctor::inline_bytes)&&
+	                        (alignof(fun)<=alignof(typename Parentfunctor::storage_type));
 };
 
-// functor filter class for 6 params
-template <typename R, typename T1, typename T2, typename T3, typename T4,
-typename T5, typename T6>
-class functionImpl<R, T1, T2, T3, T4, T5, T6>:public functionImplBase
+// clone is only requested by copyable wrapper, so move-only
+// function object never needs a copy constructor
+template <bool copyable>
+struct clone_dispatch
+{
+	template <class handle>
+	static bool clone(void* dst, void* src)
+	{
+		return handle::clone(dst, src);
+	}
+};
 
+template <>
+struct clone_dispatch<false>
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef T3 Parm3;
-	typedef T4 Parm4;
-	typedef T5 Parm5;
-	typedef T6 Parm6;
-	typedef void* Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1, Parm2, Parm3, Parm4, Parm5, Parm6) = 0;
+	template <class handle>
+	static bool clone(void*, void*)
+	{
+		UBOOST_ASSERT(false);
+		return false;
+	}
 };
 
-// functor filter class for 7 params
-template <typename R, typename T1, typename T2, typename T3, typename T4,
-typename T5, typename T6, typename T7>
-class functionImpl<R, T1, T2, T3, T4, T5, T6, T7>:public functionImplBase
+// callable object to call pointer to member function given as first
+// argument, object can be passed either by reference or by pointer
+template <typename PMF>
+struct member_caller
+{
+	PMF pmf;
+
+	member_caller(PMF _pmf)
+	:pmf(_pmf)
+	{
+	}
+
+	template <typename C, typename... A>
+	auto operator()(C&& obj, A&&... args) const
+	->decltype((forward<C>(obj).*pmf)(forward<A>(args)...))
+	{
+		return (forward<C>(obj).*pmf)(forward<A>(args)...);
+	}
+
+	template <typename C, typename... A>
+	auto operator()(C* obj, A&&... args) const
+	->decltype((obj->*pmf)(forward<A>(args)...))
+	{
+		return (obj->*pmf)(forward<A>(args)...);
+	}
+};
 
+// callable object keeping object pointer and pointer to member
+// function side by side, so bound member is called without any
+// intermediate lambda
+template <typename T, typename PMF>
+struct bound_member
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef T3 Parm3;
-	typedef T4 Parm4;
-	typedef T5 Parm5;
-	typedef T6 Parm6;
-	typedef T7 Parm7;
-	typedef void* Parm8;
-	virtual R operator()(Parm1, Parm2, Parm3, Parm4, Parm5, Parm6, Parm7) = 0;
+	T* obj;
+	PMF pmf;
+
+	bound_member(T* _obj, PMF _pmf)
+	:obj(_obj),pmf(_pmf)
+	{
+	}
+
+	template <typename... A>
+	auto operator()(A&&... args) const
+	->decltype((obj->*pmf)(forward<A>(args)...))
+	{
+		return (obj->*pmf)(forward<A>(args)...);
+	}
 };
 
-// functor filter class for 8 params
-template <typename R, typename T1, typename T2, typename T3, typename T4,
-typename T5, typename T6, typename T7, typename T8>
-class functionImpl<R, T1, T2, T3, T4, T5, T6, T7, T8>:public functionImplBase
+// type that is actually stored for incoming function object, pointer
+// to member is wrapped so it can be called with function call syntax
+template <typename fun>
+struct callable_type
+{
+	typedef fun type;
+};
 
+template <typename M, typename C>
+struct callable_type<M C::*>
 {
-	public:
-	typedef R ResultType;
-	typedef T1 Parm1;
-	typedef T2 Parm2;
-	typedef T3 Parm3;
-	typedef T4 Parm4;
-	typedef T5 Parm5;
-	typedef T6 Parm6;
-	typedef T7 Parm7;
-	typedef T8 Parm8;
-	virtual R operator()(Parm1, Parm2, Parm3, Parm4, Parm5, Parm6, Parm7, Parm8) = 0;
+	typedef member_caller<M C::*> type;
 };
 
 // template class to handle/wrap all kind of function pointer/function object
-// or lambda function reference
+// or lambda function reference. Handle has no state on its own, it only
+// provides static invoker and manager that are kept by uboost::function
+// so calling stored object doesnt need any virtual dispatch
 template <class Parentfunctor,
           typename fun,
-#ifdef USE_STATIC_ALLOCATION
-		  // in case of static allocation, we must check whether incoming function
-		  // object to be wrapped is fit with our predetermined space
-		  bool oversize=!(is_same<typename remove_reference<Parentfunctor>::type,
-		                          typename remove_reference<fun>::type>::value)&&
-		                 (sizeof(fun)+maximum_functionhandle_overhead>(maximum_function_object_size_word*4))>
-#else
-          // dynamic allocation doesnt have predetermined space issue
-          bool oversize=false>
-#endif
-class functionHandle;
+		  bool oversize=!function_fits<Parentfunctor, fun>::value>
+struct functionHandle;
 
-// main implementation
+// main implementation: function object is kept inline
 template <class Parentfunctor, typename fun>
-class functionHandle<Parentfunctor, fun, false>
-: public Parentfunctor::Impl
+struct functionHandle<Parentfunctor, fun, false>
 {
-	typedef typename Parentfunctor::Impl Base;
-	public:
-	typedef typename Base::ResultType ResultType;
-	typedef typename Base::Parm1 Parm1;
-	typedef typename Base::Parm2 Parm2;
-	typedef typename Base::Parm3 Parm3;
-	typedef typename Base::Parm4 Parm4;
-	typedef typename Base::Parm5 Parm5;
-	typedef typename Base::Parm6 Parm6;
-	typedef typename Base::Parm7 Parm7;
-	typedef typename Base::Parm8 Parm8;
-#ifdef USE_STATIC_ALLOCATION
-	virtual functionImplBase* Clone(void* buffr)const
-	{
-		return new(buffr) functionHandle(*this);
+	typedef typename Parentfunctor::ResultType ResultType;
+
+	// trivially copyable object doesnt need manager, storage
+	// is copied/relocated with memcpy() by uboost::function
+	static const bool trivial=is_trivially_copyable<fun>::value;
+
+	static fun* get(void* buffr)
+	{
+		return static_cast<fun*>(buffr);
 	}
-#else
-	virtual functionImplBase* Clone()const
+
+	// pool is only needed by oversize specialization
+	template <typename F>
+	static bool create(void* buffr, F&& _fun, function_pool*)
+	{
+		new(buffr) fun(forward<F>(_fun));
+		return true;
+	}
+
+	static bool clone(void* dst, void* src)
+	{
+		new(dst) fun(*get(src));
+		return true;
+	}
+
+	template <typename... TArgs>
+	static ResultType invoke(void* buffr, TArgs... args)
+	{
+		return (*get(buffr))(forward<TArgs>(args)...);
+	}
+
+	// return false if clone could not be made
+	static bool manage(function_op op, void* dst, void* src)
 	{
-		return new functionHandle(*this);
+		switch(op)
+		{
+			case function_op_clone:
+				return clone_dispatch<Parentfunctor::copyable>::template clone<functionHandle>(dst, src);
+			case function_op_move:
+				new(dst) fun(move(*get(src)));
+				get(src)->~fun();
+				break;
+			case function_op_destroy:
+				get(dst)->~fun();
+				break;
+		}
+		return true;
 	}
+};
+
+// spill implementation: function object is kept in a block claimed
+// from user-supplied function_pool(or heap if USE_STATIC_ALLOCATION is
+// not used and no pool is given), only the block pointer stays inline
+template <class Parentfunctor, typename fun>
+struct functionHandle<Parentfunctor, fun, true>
+{
+	typedef typename Parentfunctor::ResultType ResultType;
+
+	static const bool trivial=false;
+
+	struct block
+	{
+		template <typename F>
+		block(function_pool* _pool, F&& _fun)
+		:pool(_pool),f(forward<F>(_fun))
+		{
+		}
+
+		function_pool* pool;
+		fun f;
+	};
+
+	static block*& get(void* buffr)
+	{
+		return *static_cast<block**>(buffr);
+	}
+
+	// return false, leaving buffr untouched, if pool has no block for it
+	template <typename F>
+	static bool create(void* buffr, F&& _fun, function_pool* pool)
+	{
+		void* mem=claim(pool);
+		if(!mem)
+			return false;
+		new(buffr) block*(new(mem) block(pool, forward<F>(_fun)));
+		return true;
+	}
+
+	static bool clone(void* dst, void* src)
+	{
+		return create(dst, get(src)->f, get(src)->pool);
+	}
+
+	template <typename... TArgs>
+	static ResultType invoke(void* buffr, TArgs... args)
+	{
+		return (get(buffr)->f)(forward<TArgs>(args)...);
+	}
+
+	static bool manage(function_op op, void* dst, void* src)
+	{
+		switch(op)
+		{
+			case function_op_clone:
+				return clone_dispatch<Parentfunctor::copyable>::template clone<functionHandle>(dst, src);
+			case function_op_move:
+				// spilled object stays in its block, only pointer moves
+				new(dst) block*(get(src));
+				break;
+			case function_op_destroy:
+			{
+				block* b=get(dst);
+				function_pool* pool=b->pool;
+				b->~block();
+				release(pool, b);
+				break;
+			}
+		}
+		return true;
+	}
+
+	private:
+	static void* claim(function_pool* pool)
+	{
+#ifndef USE_STATIC_ALLOCATION
+		if(!pool)
+			return ::operator new(sizeof(block));
 #endif
+		// exhausted pool(or too small block) is a full state, checked in
+		// every mode like full uboost::listpool
+		void* mem=(sizeof(block)<=pool->block_size())?pool->claim():nullptr;
+		if(!mem)
+			UBOOST_ASSERT(false);
+		return mem;
+	}
 
-	functionHandle(const fun& _fun)
-	:f_(_fun)
+	static void release(function_pool* pool, block* b)
 	{
+#ifndef USE_STATIC_ALLOCATION
+		if(!pool)
+		{
+			::operator delete(b);
+			return;
+		}
+#endif
+		pool->free(b);
 	}
+};
+
+template <typename Sig, size_type InlineBytes, bool Copyable>
+class function_base;
 
-	functionHandle(fun&& _fun)
-	:f_(move(_fun))
+// common body of uboost::function and uboost::unique_function: inline
+// storage plus invoker and manager pointer. Copy operations are left
+// to derived class
+template <typename R, typename... TArgs, size_type InlineBytes, bool Copyable>
+class function_base<R (TArgs...), InlineBytes, Copyable>
+{
+	public:
+	// Handy type definitions for the body type
+	typedef R ResultType;
+	typedef function_storage<InlineBytes> storage_type;
+	typedef R (*invoker_type)(void*, TArgs...);
+	typedef bool (*manager_type)(function_op, void*, void*);
+
+	static const size_type inline_bytes=InlineBytes;
+	static const bool copyable=Copyable;
+
+	ResultType operator()(TArgs... args) const
 	{
+		return invoker_(buffr.buf, forward<TArgs>(args)...);
 	}
 
-	functionHandle()=delete;
+	explicit operator bool() const
+	{
+		return invoker_!=nullptr;
+	}
 
-	// operator() implementations for up to 8 arguments
+	protected:
+	template <typename fun>
+	struct stored
+	{
+		typedef typename callable_type<typename decay<fun>::type>::type type;
+	};
 
-	ResultType operator()()
-	{ return f_(); }
+	template <typename fun>
+	struct handle
+	{
+		typedef functionHandle<function_base, typename stored<fun>::type> type;
+	};
 
-	ResultType operator()(Parm1 p1)
-	{ return f_(p1); }
+	function_base()
+	:invoker_(nullptr),manager_(nullptr)
+	{}
 
-	ResultType operator()(Parm1 p1, Parm2 p2)
-	{ return f_(p1, p2); }
+	~function_base()
+	{
+		reset();
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3)
-	{ return f_(p1, p2, p3); }
+	// without pool, callable object must fit inline space
+	template <typename fun>
+	void init(fun&& _fun)
+	{
+	#ifdef USE_STATIC_ALLOCATION
+		static_assert(function_fits<function_base, typename stored<fun>::type>::value,
+		              "callable object exceeds InlineBytes, "
+		              "enlarge InlineBytes or construct with a function_pool");
+	#endif
+		init(forward<fun>(_fun), nullptr);
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4)
-	{ return f_(p1, p2, p3, p4); }
+	// function is left empty if pool can not hold callable object
+	template <typename fun>
+	void init(fun&& _fun, function_pool* pool)
+	{
+		typedef typename handle<fun>::type handle_type;
+		if(!handle_type::create(buffr.buf, forward<fun>(_fun), pool))
+			return;
+		invoker_=&handle_type::template invoke<TArgs...>;
+		manager_=handle_type::trivial?nullptr:&handle_type::manage;
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4, Parm5 p5)
-	{ return f_(p1, p2, p3, p4, p5); }
+	void copy(const function_base& rhs)
+	{
+		transfer(function_op_clone, const_cast<function_base&>(rhs));
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4, Parm5 p5, Parm6 p6)
-	{ return f_(p1, p2, p3, p4, p5, p6); }
+	// leave rhs empty
+	void steal(function_base& rhs)
+	{
+		transfer(function_op_move, rhs);
+		rhs.invoker_=nullptr;
+		rhs.manager_=nullptr;
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4, Parm5 p5, Parm6 p6, Parm7 p7)
-	{ return f_(p1, p2, p3, p4, p5, p6, p7); }
+	void reset()
+	{
+		if(manager_)
+			manager_(function_op_destroy, buffr.buf, nullptr);
+		invoker_=nullptr;
+		manager_=nullptr;
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4, Parm5 p5, Parm6 p6, Parm7 p7, Parm8 p8)
-	{ return f_(p1, p2, p3, p4, p5, p6, p7, p8); }
+	// block size of declared pool is known, so oversize callable object
+	// is checked at compile time
+	template <typename fun, size_type BlockBytes, size_type Count>
+	void init(fun&& _fun, declare::function_pool<BlockBytes, Count>* pool)
+	{
+		typedef typename stored<fun>::type stored_type;
+		static_assert(function_fits<function_base, stored_type>::value ||
+		              sizeof(stored_type)<=BlockBytes,
+		              "callable object exceeds BlockBytes of function_pool");
+		init(forward<fun>(_fun), static_cast<function_pool*>(pool));
+	}
 
 	private:
-	fun f_;
+	// clone left without pool block leaves this function empty
+	void transfer(function_op op, function_base& rhs)
+	{
+		invoker_=rhs.invoker_;
+		manager_=rhs.manager_;
+		if(rhs.manager_)
+		{
+			if(!rhs.manager_(op, buffr.buf, rhs.buffr.buf))
+			{
+				invoker_=nullptr;
+				manager_=nullptr;
+			}
+		}else if(rhs.invoker_)
+			memcpy(buffr.buf, rhs.buffr.buf, sizeof(buffr));
+	}
+
+	// spilled callable object only needs one pointer inline
+	static_assert(InlineBytes>=sizeof(void*),
+	              "function InlineBytes must hold at least one pointer");
+	mutable storage_type buffr;
+	invoker_type invoker_;
+	manager_type manager_;
 };
 
 }; // namespace _internal
 
-template <typename... T>
+template <typename Sig,
+          size_type InlineBytes=_internal::default_function_inline_bytes>
 class function;
 
 /**
@@ -399,167 +842,299 @@ class function;
  *  without dynamic allocation support, uboost::function can be implemented
  *  with full stack-based allocator via macro USE_STATIC_ALLOCATION.
  *
- *  Unlike std::function or boost::function, this uboost version still
- *  not support class member function wrapping.
+ *  Every instance reserves InlineBytes to hold the captured callable
+ *  object, so call sites that only need one or two words can declare
+ *  e.g function<void(), sizeof(void*)>. With USE_STATIC_ALLOCATION, a
+ *  callable object bigger than InlineBytes fails to compile unless a
+ *  function_pool is given at construction, in which case the object is
+ *  spilled into one block of the pool(otherwise it goes to heap). When
+ *  the pool has no free block(or its block is too small) the function is
+ *  left empty, like a full container it reports to the check handler.
+ *
+ *  Stored object is reached through an invoker and a manager function
+ *  pointer kept next to the inline space, so there is no vtable and the
+ *  whole InlineBytes is available for the callable object. Moving a
+ *  function move-constructs the stored object(or only moves the block
+ *  pointer if spilled), and trivially copyable object has no manager at
+ *  all: its inline space is simply copied with memcpy().
+ *
+ *  Class member function can be wrapped either bound to an object,
+ *  function<R(TArgs...)>(obj, &Class::method), or as pointer to member
+ *  with the object as first argument, function<R(Class&, TArgs...)>
+ *  (&Class::method). Both keep object pointer and member pointer in
+ *  inline space and call them directly.
  *
  *  @tparam R return type of function object/pointer
  *  @tparam TArgs type list of arguments
+ *  @tparam InlineBytes space reserved for callable object
  */
-template <typename R, typename... TArgs>
-class function<R (TArgs...)>
+template <typename R, typename... TArgs, size_type InlineBytes>
+class function<R (TArgs...), InlineBytes>
+:public _internal::function_base<R (TArgs...), InlineBytes, true>
 {
-	public:
-	// Handy type definitions for the body type
-	typedef _internal::functionImpl<R, TArgs...> Impl;
-	typedef R ResultType;
-	typedef typename Impl::Parm1 Parm1;
-	typedef typename Impl::Parm2 Parm2;
-	typedef typename Impl::Parm3 Parm3;
-	typedef typename Impl::Parm4 Parm4;
-	typedef typename Impl::Parm5 Parm5;
-	typedef typename Impl::Parm6 Parm6;
-	typedef typename Impl::Parm7 Parm7;
-	typedef typename Impl::Parm8 Parm8;
+	typedef _internal::function_base<R (TArgs...), InlineBytes, true> base;
 
+	// filter out function itself so copy from non-const lvalue
+	// doesnt end up in the generic constructor
+	template <typename fun>
+	struct not_self:enable_if<!is_same<typename decay<fun>::type, function>::value>{};
 
+	public:
 	// Member functions
 
-	function() : spImpl_(nullptr)
+	function()
 	{}
 
-	~function()
+	template <typename fun, typename=typename not_self<fun>::type>
+	function(fun&& _fun)
 	{
-		if(spImpl_)
-#ifdef USE_STATIC_ALLOCATION
-           spImpl_->~Impl();
-#else
-           delete spImpl_;
-#endif
+		this->init(forward<fun>(_fun));
 	}
 
-	// move to the more generalized version(below)
-	/*
-	template <typename fun>
-	function(const fun& _fun)
-#ifdef USE_STATIC_ALLOCATION
-	: spImpl_(new((void*)buffr) _internal::functionHandle<function, fun>(_fun))
-#else
-	: spImpl_(new _internal::functionHandle <function, fun>(_fun))
-#endif
+	// spill oversize callable object into pool, callable object
+	// that fits InlineBytes is still kept inline
+	template <typename fun, typename=typename not_self<fun>::type>
+	function(fun&& _fun, function_pool& pool)
 	{
+		this->init(forward<fun>(_fun), &pool);
+	}
 
-	}*/
+	// callable object is checked against BlockBytes at compile time
+	template <typename fun, size_type BlockBytes, size_type Count,
+	          typename=typename not_self<fun>::type>
+	function(fun&& _fun, declare::function_pool<BlockBytes, Count>& pool)
+	{
+		this->init(forward<fun>(_fun), &pool);
+	}
 
-	template <typename fun>
-	function(fun&& _fun)
-	#ifdef USE_STATIC_ALLOCATION
-	: spImpl_(new((void*)buffr)
-	_internal::functionHandle<function,
-	                          typename remove_reference<fun>::type >
-							  (forward<fun>(_fun) ))
-	#else
-	: spImpl_(new
-	          _internal::functionHandle <function,
-			                             typename remove_reference<fun>::type >
-										 (forward<fun>(_fun) ))
-	#endif
+	// bind member function to object given by reference or pointer
+	template <typename T, typename M, typename C>
+	function(T& obj, M C::* pmf)
 	{
+		this->init(_internal::bound_member<T, M C::*>(&obj, pmf));
 	}
 
+	template <typename T, typename M, typename C>
+	function(T* obj, M C::* pmf)
+	{
+		this->init(_internal::bound_member<T, M C::*>(obj, pmf));
+	}
 
 	function(const function& rhs)
-	#ifdef USE_STATIC_ALLOCATION
-	:spImpl_(static_cast<Impl*>( rhs.spImpl_->Clone((void*)buffr))  )
-	#else
-	:spImpl_(static_cast<Impl*>( rhs.spImpl_->Clone()  ))
-	#endif
 	{
+		this->copy(rhs);
 	}
 
-
 	function(function&& rhs)
-	#ifdef USE_STATIC_ALLOCATION
-	:spImpl_(static_cast<Impl*>( rhs.spImpl_->Clone((void*)buffr))  )
-	#else
-	:spImpl_(static_cast<Impl*>(rhs.spImpl_))
-	#endif
 	{
-		rhs.spImpl_=nullptr;
+		this->steal(rhs);
 	}
 
-
 	function& operator=(const function& rhs)
 	{
-		if(spImpl_)
-#ifdef USE_STATIC_ALLOCATION
-			spImpl_->~Impl();
-		spImpl_=static_cast<Impl*>(rhs.spImpl_->Clone((void*)buffr));
-#else
-			delete spImpl_;
-		spImpl_=static_cast<Impl*>(rhs.spImpl_->Clone());
-#endif
+		if(this!=&rhs)
+		{
+			this->reset();
+			this->copy(rhs);
+		}
+		return *this;
+	}
 
+	function& operator=(function&& rhs)
+	{
+		if(this!=&rhs)
+		{
+			this->reset();
+			this->steal(rhs);
+		}
 		return *this;
 	}
+};
 
-    function& operator=(function&& rhs)
-    {
-	    if(spImpl_)
-		#ifdef USE_STATIC_ALLOCATION
-		    spImpl_->~Impl();
-		#else
-	        delete spImpl_;
-		#endif
+template <typename Sig,
+          size_type InlineBytes=_internal::default_function_inline_bytes>
+class unique_function;
 
-	    #ifdef USE_STATIC_ALLOCATION
-		spImpl_=static_cast<Impl*>(rhs.spImpl_->Clone((void*)buffr));
-		#else
-		spImpl_=static_cast<Impl*>(rhs.spImpl_);
-		#endif
+/**
+ *  @brief move-only variant of uboost::function
+ *
+ *  uboost::unique_function keeps callable object in the same inline
+ *  storage(or function_pool block) as uboost::function, but it can only
+ *  be moved. Hence the callable object itself only needs to be movable,
+ *  so lambda capturing move-only resource can be handed over without
+ *  any copy(e.g as work item of a task queue).
+ *
+ *  @tparam R return type of function object/pointer
+ *  @tparam TArgs type list of arguments
+ *  @tparam InlineBytes space reserved for callable object
+ */
+template <typename R, typename... TArgs, size_type InlineBytes>
+class unique_function<R (TArgs...), InlineBytes>
+:public _internal::function_base<R (TArgs...), InlineBytes, false>
+{
+	typedef _internal::function_base<R (TArgs...), InlineBytes, false> base;
 
-		rhs.spImpl_=nullptr;
+	template <typename fun>
+	struct not_self:enable_if<!is_same<typename decay<fun>::type, unique_function>::value>{};
 
-	    return *this;
-    }
+	public:
+	unique_function()
+	{}
 
-	ResultType operator()() const
-	{ return (*spImpl_)(); }
+	template <typename fun, typename=typename not_self<fun>::type>
+	unique_function(fun&& _fun)
+	{
+		this->init(forward<fun>(_fun));
+	}
 
-	ResultType operator()(Parm1 p1) const
-	{ return (*spImpl_)(p1); }
+	template <typename fun, typename=typename not_self<fun>::type>
+	unique_function(fun&& _fun, function_pool& pool)
+	{
+		this->init(forward<fun>(_fun), &pool);
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2) const
-	{ return (*spImpl_)(p1, p2); }
+	template <typename fun, size_type BlockBytes, size_type Count,
+	          typename=typename not_self<fun>::type>
+	unique_function(fun&& _fun, declare::function_pool<BlockBytes, Count>& pool)
+	{
+		this->init(forward<fun>(_fun), &pool);
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3) const
-	{ return (*spImpl_)(p1, p2, p3); }
+	// bind member function to object given by reference or pointer
+	template <typename T, typename M, typename C>
+	unique_function(T& obj, M C::* pmf)
+	{
+		this->init(_internal::bound_member<T, M C::*>(&obj, pmf));
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4) const
-	{ return (*spImpl_)(p1, p2, p3, p4); }
+	template <typename T, typename M, typename C>
+	unique_function(T* obj, M C::* pmf)
+	{
+		this->init(_internal::bound_member<T, M C::*>(obj, pmf));
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4,
-	                      Parm5 p5) const
-	{ return (*spImpl_)(p1, p2, p3, p4, p5); }
+	unique_function(const unique_function&)=delete;
+	unique_function& operator=(const unique_function&)=delete;
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4,
-	                      Parm5 p5, Parm6 p6) const
-	{ return (*spImpl_)(p1, p2, p3, p4, p5, p6); }
+	unique_function(unique_function&& rhs)
+	{
+		this->steal(rhs);
+	}
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4,
-	                      Parm5 p5, Parm6 p6, Parm7 p7) const
-	{ return (*spImpl_)(p1, p2, p3, p4, p5, p6, p7); }
+	unique_function& operator=(unique_function&& rhs)
+	{
+		if(this!=&rhs)
+		{
+			this->reset();
+			this->steal(rhs);
+		}
+		return *this;
+	}
+};
 
-	ResultType operator()(Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4,
-	                      Parm5 p5, Parm6 p6, Parm7 p7, Parm8 p8) const
-	{ return (*spImpl_)(p1, p2, p3, p4, p5, p6, p7, p8); }
+template <typename Sig>
+class function_ref;
+
+/**
+ *  @brief non-owning reference to callable object or function pointer
+ *
+ *  uboost::function_ref only keeps address of referenced callable object
+ *  (or the function pointer itself) plus one trampoline pointer, so it
+ *  is two words wide, trivially copyable and constructing it never
+ *  copies anything. It is intended for parameter of function that only
+ *  calls the callback synchronously. As it doesnt own the callable
+ *  object, referenced object(including temporary lambda) must outlive
+ *  the function_ref.
+ *
+ *  @tparam R return type of function object/pointer
+ *  @tparam TArgs type list of arguments
+ */
+template <typename R, typename... TArgs>
+class function_ref<R (TArgs...)>
+{
+	union target
+	{
+		void* obj;
+		void (*fn)();
+	};
+
+	typedef R (*pointer_type)(TArgs...);
+
+	template <typename fun>
+	struct callable_object:enable_if<!is_same<typename decay<fun>::type, function_ref>::value&&
+	                                 !is_same<typename decay<fun>::type, pointer_type>::value>{};
+
+	public:
+	typedef R ResultType;
+
+	template <typename fun, typename=typename callable_object<fun>::type>
+	function_ref(fun&& _fun)
+	:call_(&call_object<typename remove_reference<fun>::type>)
+	{
+		target_.obj=const_cast<void*>(static_cast<const void*>(&_fun));
+	}
+
+	function_ref(pointer_type _fun)
+	:call_(&call_pointer)
+	{
+		target_.fn=reinterpret_cast<void (*)()>(_fun);
+	}
+
+	function_ref()=delete;
+
+	ResultType operator()(TArgs... args) const
+	{
+		return call_(target_, forward<TArgs>(args)...);
+	}
 
 	private:
-#ifdef USE_STATIC_ALLOCATION
-	uint32_t buffr[_internal::maximum_function_object_size_word];
-#endif
-	Impl *spImpl_;
+	template <typename fun>
+	static R call_object(target t, TArgs... args)
+	{
+		return (*static_cast<fun*>(t.obj))(forward<TArgs>(args)...);
+	}
+
+	static R call_pointer(target t, TArgs... args)
+	{
+		return reinterpret_cast<pointer_type>(t.fn)(forward<TArgs>(args)...);
+	}
+
+	target target_;
+	R (*call_)(target, TArgs...);
 };
 
+namespace declare
+{
+
+/**
+ *  @brief declaration point of uboost::function_pool, reserve
+ *  space for Count blocks of BlockBytes each
+ *  @tparam BlockBytes maximum size of single spilled callable object
+ *  @tparam Count number of blocks
+ */
+template <size_type BlockBytes, size_type Count>
+class function_pool:public uboost::function_pool
+{
+	public:
+	// every block keeps owning pool pointer in front of callable object,
+	// and should keep following block aligned
+	static const size_type block_bytes=
+	    (sizeof(void*)+BlockBytes+sizeof(double)-1)/sizeof(double)*sizeof(double);
+
+	function_pool()
+	:uboost::function_pool(_buf.buf, block_bytes, Count){};
+
+	function_pool(const function_pool&)=delete;
+	function_pool(function_pool&&)=delete;
+	function_pool& operator=(const function_pool&)=delete;
+	function_pool& operator=(function_pool&&)=delete;
+
+	private:
+	_internal::function_storage<block_bytes*Count> _buf;
+};
+
+};//namespace declare
+
 template<typename... T>
 struct simple_tuple;
 
@@ -41,18 +41,137 @@ struct resize_dispatch<false>
     template<class vector>
     static void emplace_narg(vector& v)
     {
-        assert(false);
+        UBOOST_ASSERT(false);
     }
 };
 
+/**
+ *  @brief bulk element moves used by uboost::vector, element by element
+ *  version for non trivially copyable types
+ */
+template <bool trivially_copyable>
+struct move_dispatch
+{
+    // shift [pos, sz) to [pos+n, sz+n), [pos, pos+n) is left unconstructed
+    template <class T, class S>
+    static void open_gap(T* buf, S sz, S pos, S n)
+    {
+        for(S i=sz+n;i-->pos+n;)
+        {
+            if(i>=sz)
+                new(&buf[i]) T(move(buf[i-n]));
+            else
+                buf[i]=move(buf[i-n]);
+        };
+        for(S i=pos;(i<pos+n)&&(i<sz);i++)
+            buf[i].~T();
+    };
+
+    // destroy [pos, pos+n) and shift [pos+n, sz) down to pos
+    template <class T, class S>
+    static void close_gap(T* buf, S sz, S pos, S n)
+    {
+        for(S i=pos;i+n<sz;i++)
+            buf[i]=move(buf[i+n]);
+        for(S i=sz-n;i<sz;i++)
+            buf[i].~T();
+    };
+
+    // replace sz elements of buf with n elements of src
+    template <class T, class S>
+    static void copy(T* buf, S sz, const T* src, S n)
+    {
+        for(S i=0;i<n;i++)
+        {
+            if(i<sz)
+                buf[i]=src[i];
+            else
+                new(&buf[i]) T(src[i]);
+        }
+        for(S i=n;i<sz;i++)
+            buf[i].~T();
+    };
+
+    // construct n copies of val on unconstructed space
+    template <class T, class S>
+    static void fill(T* buf, S n, const T& val)
+    {
+        for(S i=0;i<n;i++)
+            new(&buf[i]) T(val);
+    };
+};
+
+// trivially copyable types are moved as raw memory
+template <>
+struct move_dispatch<true>
+{
+    template <class T, class S>
+    static void open_gap(T* buf, S sz, S pos, S n)
+    {
+        memmove(&buf[pos+n], &buf[pos], (sz-pos)*sizeof(T));
+    };
+
+    template <class T, class S>
+    static void close_gap(T* buf, S sz, S pos, S n)
+    {
+        memmove(&buf[pos], &buf[pos+n], (sz-pos-n)*sizeof(T));
+    };
+
+    template <class T, class S>
+    static void copy(T* buf, S, const T* src, S n)
+    {
+        // source may be part of buf
+        memmove(buf, src, n*sizeof(T));
+    };
+
+    template <class T, class S>
+    static void fill(T* buf, S n, const T& val)
+    {
+        if(sizeof(T)==1)
+            memset(buf, *reinterpret_cast<const uint8_t*>(&val), n);
+        else
+            for(T* end=buf+n;buf!=end;buf++)
+                *buf=val;
+    };
+};
+
+template <bool trivially_destructible>
+struct destroy_dispatch
+{
+    template <class T>
+    static void destroy(T* first, T* last)
+    {
+        while(last!=first)
+            (--last)->~T();
+    };
+};
+
+template <>
+struct destroy_dispatch<true>
+{
+    template <class T>
+    static void destroy(T*, T*)
+    {
+    };
+};
+
 };//internal
-template <class T>
+/**
+ *  @brief statically allocated vector container, used to pass vector
+ *  reference around while uboost::declare::vector is the declaration point
+ *  @tparam T type of contained object
+ *  @tparam SizeT unsigned type of size and index, should be able to hold
+ *  the capacity(see uboost::index_type)
+ */
+template <class T, class SizeT=size_type>
 class vector
 {
 	public:
 	typedef T& reference;
 	typedef const T& const_reference;
 	typedef T value_type;
+	typedef SizeT size_type;
+	typedef typename make_difference<SizeT>::type difference_type;
 
 	protected:
 	/*struct T_container
@@ -72,6 +191,9 @@ class vector
 	protected:
 	explicit vector (T* __buff, size_type __cap)
 	:_buf(__buff),_capacity(__cap),_sz(0)
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+	,_version(0)
+#endif
 	{};
 	public:
 	vector()=delete;
@@ -86,23 +208,26 @@ class vector
     //vector (T* __buff, size_type __cap, initializer_list<value_type> il);
 
 	//destructor
-	virtual ~vector()
+	// not virtual, so vector carries no vtable pointer. It is protected
+	// as vector is only destroyed through its declaration point
+	// (uboost::declare::vector), never through base reference
+	protected:
+	~vector()
 	{
-		resize(0);
+		shrink(0);
 	};
+	public:
 
 	//at
 	reference at(size_type n)
 	{
-		rangecheck(n);
-		assert(n<_sz);
+		UBOOST_ASSERT(n<_sz);
 		return _buf[n];
 	};
 
 	const_reference at(size_type n)const
 	{
-		rangecheck(n);
-		assert(n<_sz);
+		UBOOST_ASSERT(n<_sz);
 		return _buf[n];
 	};
 
@@ -126,7 +251,7 @@ class vector
 	//clear
 	void clear()
 	{
-		resize(0);
+		shrink(0);
 	};
 
 	//data
@@ -144,10 +269,31 @@ class vector
 	template <class... Args>
 	void emplace_back (Args&&... args)
 	{
-		rangecheck(_sz);
+		if(!rangecheck(_sz))
+			return;
 		new(&_buf[_sz++]) T(uboost::forward<Args>(args)...);
 	};
 
+	//emplace_back_n, construct n elements from same arguments
+	template <class... Args>
+	void emplace_back_n (size_type n, const Args&... args)
+	{
+		if(!UBOOST_CHECK(n<=_capacity-_sz))
+			return;
+		T* p=_buf+_sz;
+		for(size_type i=0;i<n;i++)
+			new(&p[i]) T(args...);
+		_sz+=n;
+	};
+
+	//append
+	template <class InputIterator>
+	void append (InputIterator first, InputIterator last)
+	{
+		insert_range(_sz, first, last,
+		             typename iterator_traits<InputIterator>::iterator_category());
+	};
+
 	//empty
 	bool empty() const
 	{
@@ -184,48 +330,106 @@ class vector
 	    this->assign(move_iterator <vector::iterator>(x.begin()),
 	                 move_iterator <vector::iterator>(x.end()));
         x.clear();
+        return *this;
 	};
 	//vector& operator= (initializer_list<value_type> il);
 
+	// evaluate element-wise expression(see algorithm/expression.hpp)
+	// in one pass, destination may be one of its operands
+	template <class E>
+	typename enable_if<E::vector_expression_tag, vector&>::type operator=(const E& e)
+	{
+	    size_type n=size_type(e.size());
+	    // bulk assignment is clamped to capacity in every mode
+	    if(n>_capacity)
+	    {
+	        UBOOST_ASSERT(false);
+	        n=_capacity;
+	    }
+	    size_type m=(n<_sz)?n:_sz;
+	    T* buf=_buf;
+	    invalidate();
+	    for(size_type i=0;i<m;i++)
+	        buf[i]=e[i];
+	    for(size_type i=m;i<n;i++)
+	        new(&buf[i]) T(e[i]);
+	    shrink(n);
+	    _sz=n;
+	    return *this;
+	};
+
 	//element access operator
 	reference operator[](size_type n)
 	{
-		return at(n);
+		UBOOST_ASSERT(n<_sz);
+		return _buf[n];
 	};
 
 	const_reference operator[] (size_type n) const
 	{
-		return at(n);
+		UBOOST_ASSERT(n<_sz);
+		return _buf[n];
 	};
 
 	//pop_back
 	void pop_back()
 	{
-		assert(_sz--);
-		at(_sz).~T();
+		if(!UBOOST_CHECK(_sz))
+			return;
+		invalidate();
+		_buf[--_sz].~T();
 	};
 
 	//push_back
     template <typename Tt>
 	void push_back(Tt&& val)
 	{
-		rangecheck(_sz);
+		if(!rangecheck(_sz))
+			return;
 		new(&_buf[_sz++]) T(forward<Tt>(val));
 	}
 
 	//reserve
 	void reserve(size_type n)
 	{
-		assert(n<=_capacity);
+		UBOOST_ASSERT(n<=_capacity);
 	}
 
 	//resize
 	void resize(size_type n, const T& val)
 	{
-        while(n>_sz)
-            push_back(val);
-	    while(n<_sz)
-            pop_back();
+	    if(n>_sz)
+	    {
+	        if(!UBOOST_CHECK(n<=_capacity))
+	            return;
+	        mover::fill(_buf+_sz, size_type(n-_sz), val);
+	        _sz=n;
+	    }else
+	        shrink(n);
+	};
+
+	// grow without initializing new elements, for T that is about to be
+	// overwritten(e.g. by read()). Shrinking works like resize()
+	void resize_for_overwrite(size_type n)
+	{
+		static_assert(is_trivially_copyable<T>::value,
+		              "uninitialized growth needs trivially copyable element");
+		if(!UBOOST_CHECK(n<=_capacity))
+			return;
+		if(n<_sz)
+			shrink(n);
+		_sz=n;
+	};
+
+	// grow by n uninitialized elements and return pointer to the first
+	// one(see resize_for_overwrite()), nullptr if they dont fit
+	T* append_uninitialized(size_type n)
+	{
+		if(!UBOOST_CHECK(n<=_capacity-_sz))
+			return nullptr;
+		T* p=_buf+_sz;
+		resize_for_overwrite(_sz+n);
+		return p;
 	};
 
 	void resize(size_type n)
@@ -234,10 +438,8 @@ class vector
 		//containing object with no default constructor
         //typedef internal::resize_dispatch<true> dispatcher;
         while(n>_sz)
-            emplace_back();
-            //dispatcher::emplace_narg(*this);
-	    while(n<_sz)
-            pop_back();
+            emplace_back(); //dispatcher::emplace_narg(*this);
+        shrink(n);
 	};
 
 	//shrink_to_fit
@@ -256,146 +458,210 @@ class vector
 	//swap
 	//void swap (vector& x)
 	//{
-    //    assert(false);
+    //    UBOOST_ASSERT(false);
 	//}
 
 	private:
-	void rangecheck(int n)
+	// false if n is past capacity(never in unchecked mode)
+	bool rangecheck(size_type n) const
 	{
-		if((n<0)||(n>=_capacity))assert(false);
+		(void)n;
+		return UBOOST_CHECK(n<_capacity);
 	};
+
+	// iterators created before are no longer valid(debug mode only)
+	void invalidate()
+	{
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		_version++;
+#endif
+	};
+
 	protected:
 
 	T* _buf;
 	size_type _capacity;
 	size_type _sz;
-
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+	// bumped whenever elements are moved or destroyed
+	uint16_t _version;
+#endif
+
+	/**
+	 *  @brief contiguous iterator, a thin wrapper of element pointer
+	 *  so loops over begin()/end() compile like loops over raw array.
+	 *  In UBOOST_CHECK_DEBUG mode it also keeps its vector and vector
+	 *  version, and reports use after the vector moved or destroyed
+	 *  elements(any erase, insert, pop_back, shrinking or assignment)
+	 */
 	template <bool is_const=false>
-	struct iterator_base/*:public
-						 uboost::iterator<random_access_iterator_tag,
-	                                      T,
-										  ptrdiff_t,
-										  typename conditional<is_const,const T*,T*>::type,
-										  typename conditional<is_const,const T&,T&>::type>*/
+	struct iterator_base
 	{
 		public:
 
 		typedef random_access_iterator_tag  iterator_category;
 		typedef T                           value_type;
-		typedef ptrdiff_t                   difference_type;
+		typedef typename vector::difference_type difference_type;
 		typedef typename conditional<is_const,const T*,T*>::type  pointer;
 		typedef typename conditional<is_const,const T&,T&>::type  reference;
 
-
-	    iterator_base(typename conditional<is_const,const vector&,vector&>::type x,
-	                  const ptrdiff_t &_pos):container(&x),pos(_pos){};
+		iterator_base()
+		:ptr(nullptr)
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		,owner(nullptr),version(0)
+#endif
+		{};
+
+		explicit iterator_base(pointer p, const vector* o=nullptr)
+		:ptr(p)
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		,owner(o),version(o?o->_version:0)
+#endif
+		{(void)o;};
+
+		// iterator to const_iterator conversion only
+		template<bool _B, class=typename enable_if<!_B || is_const>::type>
+		iterator_base(const iterator_base<_B>& it)
+		:ptr(it.ptr)
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		,owner(it.owner),version(it.version)
+#endif
+		{};
 
 		iterator_base& operator++()
 		{
-			pos++;
+			ptr++;
 			return *this;
 		};
 
 		iterator_base operator++(int)
 		{
 			iterator_base temp = *this;
-			pos++;
+			ptr++;
 			return temp;
 		};
 
 		iterator_base& operator--()
 		{
-			pos--;
+			ptr--;
 			return *this;
 		};
 
 		iterator_base operator--(int)
 		{
 			iterator_base temp = *this;
-			pos--;
+			ptr--;
 			return temp;
 		};
 
 		template<bool _B>
 		bool operator==(const iterator_base<_B>& C) const
 		{
-			return (pos==C.pos);
+			return (ptr==C.ptr);
 		};
 
 		template<bool _B>
 		bool operator!=(const iterator_base<_B>&C) const
 		{
-			return (pos!=C->pos);
+			return (ptr!=C.ptr);
 		};
 
 		template<bool _B>
 		bool operator<(const iterator_base<_B>&C) const
 		{
-			return (pos<C.pos);
+			return (ptr<C.ptr);
 		};
 
 		template<bool _B>
 		bool operator>(const iterator_base<_B>&C) const
 		{
-			return (pos>C.pos);
+			return (ptr>C.ptr);
 		};
 
 		template<bool _B>
 		bool operator<=(const iterator_base<_B>&C) const
 		{
-			return (pos<=C.pos);
+			return (ptr<=C.ptr);
 		};
 
 		template<bool _B>
 		bool operator>=(const iterator_base<_B>&C) const
 		{
-			return (pos>=C.pos);
+			return (ptr>=C.ptr);
 		};
 
         reference operator*() const
 		{
-			return container->_buf[pos];
+			check(ptr);
+			return *ptr;
 		};
 
+        // never dereferences, so it is valid on end() as well
         pointer operator->() const
 		{
-			return &(container->_buf[pos]);
+			check(nullptr);
+			return ptr;
 		};
 
         reference operator[](difference_type i) const
 		{
-			return container->_buf[pos+i];
+			check(ptr+i);
+			return ptr[i];
 		};
 
 		iterator_base operator+(difference_type n)const
 		{
 			iterator_base temp=*this;
-			temp.pos+=n;
+			temp.ptr+=n;
 			return temp;
 		};
 
 		iterator_base operator-(difference_type n)const
 		{
 			iterator_base temp=*this;
-			temp.pos-=n;
+			temp.ptr-=n;
 			return temp;
 		};
 
 		iterator_base& operator+=(difference_type n)
 		{
-			pos+=n;
+			ptr+=n;
 			return *this;
 		};
 
 		iterator_base& operator-= (difference_type n)
 		{
-			pos-=n;
+			ptr-=n;
 			return *this;
 		}
 
+		template<bool _B>
+		difference_type operator-(const iterator_base<_B>& C) const
+		{
+			return ptr-C.ptr;
+		};
+
 		private:
-		typename conditional<is_const,const vector*,vector*>::type  container;
-		ptrdiff_t pos;
+		// p is element about to be accessed, nullptr if none
+		void check(const T* p) const
+		{
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+			if(!owner)
+				return;
+			UBOOST_ASSERT(version==owner->_version);
+			UBOOST_ASSERT(!p || (p>=owner->_buf && p<owner->_buf+owner->_sz));
+#endif
+			(void)p;
+		};
+
+		pointer ptr;
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+		const vector* owner;
+		uint16_t version;
+#endif
+
+		friend class vector;
+		template <bool> friend struct iterator_base;
 	};
 
 
@@ -406,121 +672,230 @@ class vector
 	typedef uboost::reverse_iterator<const_iterator> const_reverse_iterator;
 
 	private:
+	typedef internal::move_dispatch<is_trivially_copyable<T>::value> mover;
+	typedef internal::destroy_dispatch<is_trivially_destructible<T>::value> destroyer;
+
 	// this is internal function and not should be called alone as
-	// this function temporarily leave list in undefined state
-	void open_gap(iterator first, size_type n)
+	// this function temporarily leave list in undefined state:
+	// [pos, pos+n) is left unconstructed for the caller to fill.
+	// Return false, leaving vector untouched, if n elements dont fit
+	bool open_gap(size_type pos, size_type n)
 	{
-	    if(!n)return;
-        assert((_sz+n)<=_capacity);
+	    if(!n)return true;
+        if(!UBOOST_CHECK(n<=_capacity-_sz))
+            return false;
+        invalidate();
+        mover::open_gap(_buf, _sz, pos, n);
         _sz+=n;
-        reverse_iterator rfirst(rend());
-        reverse_iterator rlast(first);
-        int i=0;
-        for(;rfirst!=rlast;rfirst++)
-        {
-			if((i++)<n)
-			    new(&rfirst[0]) T(move(rfirst[n]));
-			else
-                *rfirst=move(rfirst[n]);
-        };
-		rfirst[n].~T();
+        return true;
+	};
+
+	// drop elements past n
+	void shrink(size_type n)
+	{
+	    if(n>=_sz)return;
+	    invalidate();
+	    destroyer::destroy(_buf+n, _buf+_sz);
+	    _sz=n;
+	};
+
+	// contiguous source, dispatched to bulk copy
+	void assign_range(const T* first, const T* last)
+	{
+	    size_type n=last-first;
+	    // bulk assignment is clamped to capacity in every mode
+	    if(n>_capacity)
+	    {
+	        UBOOST_ASSERT(false);
+	        n=_capacity;
+	    }
+	    invalidate();
+	    mover::copy(_buf, _sz, first, n);
+	    _sz=n;
+	};
+
+	void assign_range(T* first, T* last)
+	{
+	    assign_range(const_cast<const T*>(first), const_cast<const T*>(last));
+	};
+
+	void assign_range(const_iterator first, const_iterator last)
+	{
+	    assign_range(to_address(first), to_address(last));
+	};
+
+	void assign_range(iterator first, iterator last)
+	{
+	    assign_range(to_address(first), to_address(last));
 	};
 
-	public:
-	//assign
 	template <class InputIterator>
-	void assign (InputIterator first, InputIterator last)
+	void assign_range(InputIterator first, InputIterator last)
 	{
-        iterator thisIt=begin();
+        invalidate();
         size_type i=0;
         for(InputIterator it=first;
-            it<last ;
+            it!=last ;
             it++)
         {
-            assert(i<_capacity);
-            if((thisIt+i)<end())
+            // rest of range is dropped
+            if(i==_capacity)
             {
-                //T temp(*it);
-				//this:
-                //thisIt[i].~T();
-                //new(&thisIt[i++]) T(move(temp));
-				//or, use move instead:
-				//thisIt[i++]=move(temp);
-				thisIt[i++]=*it;
-            }else
-            {
-                //push_back(*it);
-                new(&thisIt[i++]) T(*it);
+                UBOOST_ASSERT(false);
+                break;
             }
+            if(i<_sz)
+				_buf[i++]=*it;
+            else
+                new(&_buf[i++]) T(*it);
         }
-        if(!i &&_sz)
-           resize(0);
-        else
-           _sz=i;
+        // destroy leftover
+        shrink(i);
+        _sz=i;
+	};
+
+	// construct n elements on unconstructed dst, contiguous source is
+	// dispatched to bulk copy
+	void construct_range(T* dst, const T* first, size_type n)
+	{
+	    mover::copy(dst, size_type(0), first, n);
+	};
+
+	void construct_range(T* dst, const_iterator first, size_type n)
+	{
+	    construct_range(dst, to_address(first), n);
+	};
+
+	void construct_range(T* dst, iterator first, size_type n)
+	{
+	    construct_range(dst, to_address(first), n);
+	};
+
+	template <class InputIterator>
+	void construct_range(T* dst, InputIterator first, size_type n)
+	{
+	    for(size_type i=0;i<n;i++,++first)
+	        new(&dst[i]) T(*first);
+	};
+
+	// index of iterator to this vector, validated in checked modes
+	size_type position_of(const_iterator it) const
+	{
+	    it.check(nullptr);
+	    const T* p=to_address(it);
+	    UBOOST_ASSERT(p>=_buf && p<=_buf+_sz);
+	    return size_type(p-_buf);
+	};
+
+	// reverse [first, last) by swapping
+	void reverse_range(size_type first, size_type last)
+	{
+	    while(first+1<last)
+	    {
+	        T temp(move(_buf[first]));
+	        _buf[first++]=move(_buf[--last]);
+	        _buf[last]=move(temp);
+	    }
+	};
+
+	// values of single-pass iterator can only be counted by reading
+	// them, so they are buffered in spare capacity then rotated in place
+	template <class InputIterator>
+	size_type insert_range(size_type pos, InputIterator first, InputIterator last,
+	                       input_iterator_tag)
+	{
+	    size_type old=_sz;
+	    for(;first!=last;++first)
+	        emplace_back(*first);
+	    if(pos!=old)
+	        invalidate();
+	    reverse_range(pos, old);
+	    reverse_range(old, _sz);
+	    reverse_range(pos, _sz);
+	    return _sz-old;
+	};
+
+	template <class ForwardIterator, class Tag>
+	size_type insert_range(size_type pos, ForwardIterator first, ForwardIterator last,
+	                       Tag)
+	{
+	    size_type n=size_type(distance(first, last));
+	    if(!open_gap(pos, n))
+	        return 0;
+	    construct_range(_buf+pos, first, n);
+	    return n;
+	};
+
+	public:
+	//assign
+	template <class InputIterator>
+	typename enable_if<!is_integral<InputIterator>::value>::type
+	assign (InputIterator first, InputIterator last)
+	{
+	    assign_range(first, last);
 	};
 
 	void assign (size_type n, const T& val)
 	{
-	    resize(0);
-        for(size_type i=0;i<n;i++)
-            push_back(val);
+	    shrink(0);
+	    resize(n, val);
 	}
 	//void assign (initializer_list<value_type> il);
 
 	//begin
 	iterator begin()
 	{
-		return iterator(*this, 0);
+		return iterator(_buf, this);
 	};
 
 	const_iterator begin() const
 	{
-		return const_iterator(*this, 0);
+		return const_iterator(_buf, this);
 	};
 
 	//cbegin
 	const_iterator cbegin() const
 	{
-		return const_iterator(*this, 0);
+		return const_iterator(_buf, this);
 	};
 
 	//cend
 	const_iterator cend() const
 	{
-		return const_iterator(*this, _sz);
+		return const_iterator(_buf+_sz, this);
 	};
 
 	//constant reverse iterators
 	const_reverse_iterator crbegin() const
 	{
-		return const_reverse_iterator(const_iterator(*this, 0));
+		return const_reverse_iterator(const_iterator(_buf+_sz, this));
 	};
 
 	const_reverse_iterator crend() const
 	{
-		return const_reverse_iterator(const_iterator(*this, _sz));
+		return const_reverse_iterator(const_iterator(_buf, this));
 	}
 
 	//emplace
 	template <class... Args>
 	iterator emplace (const_iterator position, Args&&... args)
 	{
-	    rangecheck(_sz);
-	    open_gap(position, 1);
-	    new(&position[0]) T(uboost::forward<Args>(args)...);
-	    return position;
+	    size_type pos=position_of(position);
+	    if(open_gap(pos, 1))
+	        new(&_buf[pos]) T(uboost::forward<Args>(args)...);
+	    return iterator(_buf+pos, this);
 	};
 
 
 	//end
 	iterator end()
 	{
-		return iterator(*this, _sz);
+		return iterator(_buf+_sz, this);
 	};
 
 	const_iterator end() const
 	{
-		return const_iterator(*this, _sz);
+		return const_iterator(_buf+_sz, this);
 	};
 
 	//erase
@@ -531,38 +906,43 @@ class vector
 
 	iterator erase (const_iterator first, const_iterator last)
 	{
-	    const_iterator saved=first;
-	    size_type i=0;
-        while(first<last)
-        {
-            if(first<cend())
-            {
-                first->~T();
-            }break;
-            first++;
-            i++;
-        };
-        iterator deleted=saved;
-        while(first<cend())
-        {
-            *deleted++=move(*first);
-            first++->~T();
-        }
-        _sz-=i;
-        return saved;
+	    size_type pos=position_of(first);
+	    size_type n=position_of(last)-pos;
+	    if(n)
+	    {
+	        invalidate();
+	        mover::close_gap(_buf, _sz, pos, n);
+	    }
+        _sz-=n;
+        return iterator(_buf+pos, this);
+	};
+
+	//erase_if, remove elements matching pred in one compacting pass,
+	//return number of removed elements
+	template <class Predicate>
+	size_type erase_if (Predicate pred)
+	{
+	    size_type w=0;
+	    for(size_type r=0;r<_sz;r++)
+	    {
+	        if(pred(_buf[r]))
+	            continue;
+	        if(w!=r)
+	            _buf[w]=move(_buf[r]);
+	        w++;
+	    }
+	    size_type n=_sz-w;
+	    shrink(w);
+	    return n;
 	};
 
 	//insert
 	iterator insert (const_iterator position, size_type n, const value_type& val)
 	{
-	    if(n){
-	    open_gap(position, n);
-        while(n)
-        {
-            new (&position[--n]) T(val);
-        };
-        }
-        return iterator(position);
+	    size_type pos=position_of(position);
+	    if(open_gap(pos, n))
+	        mover::fill(_buf+pos, n, val);
+        return iterator(_buf+pos, this);
 	};
 
 	iterator insert (const_iterator position, const value_type& val)
@@ -570,41 +950,47 @@ class vector
 	    return insert(position, 1, val);
 	};
 
-	//!!!TODO: support this
-	//template <class InputIterator>
-	//iterator insert (const_iterator position, InputIterator first, InputIterator last)
-	//{
-	//    assert(false);
-	//};
+	// gap is opened once, single-pass iterator values are appended then
+	// rotated into position
+	template <class InputIterator>
+	typename enable_if<!is_integral<InputIterator>::value, iterator>::type
+	insert (const_iterator position, InputIterator first, InputIterator last)
+	{
+	    size_type pos=position_of(position);
+	    insert_range(pos, first, last,
+	                 typename iterator_traits<InputIterator>::iterator_category());
+	    return iterator(_buf+pos, this);
+	};
 
 	iterator insert (const_iterator position, value_type&& val)
 	{
-	    open_gap(position, 1);
-        new (&position[0]) T(move(val));
-        return iterator(position);
+	    size_type pos=position_of(position);
+	    if(open_gap(pos, 1))
+            new (&_buf[pos]) T(move(val));
+        return iterator(_buf+pos, this);
 	};
 	//iterator insert (const_iterator position, initializer_list<value_type> il);
 
 	//rbegin
 	reverse_iterator rbegin()
 	{
-		return reverse_iterator(iterator(*this, 0));
+		return reverse_iterator(iterator(_buf+_sz, this));
 	};
 
 	const_reverse_iterator rbegin() const
 	{
-		return const_reverse_iterator(const_iterator(*this, 0));
+		return const_reverse_iterator(const_iterator(_buf+_sz, this));
 	};
 
 	//rend
 	reverse_iterator rend()
 	{
-		return reverse_iterator(iterator(*this, _sz));
+		return reverse_iterator(iterator(_buf, this));
 	};
 
 	const_reverse_iterator rend() const
 	{
-		return const_reverse_iterator(const_iterator(*this, _sz));
+		return const_reverse_iterator(const_iterator(_buf, this));
 	};
 
 	//TODO: support relational operators
@@ -612,24 +998,43 @@ class vector
 
 namespace declare
 {
-template <class T, uint16_t Size>
-class vector:public uboost::vector<T>
+/**
+ *  @brief declaration point of uboost::vector, reserve space for Size
+ *  elements
+ *  @tparam T type of contained object
+ *  @tparam Size capacity
+ *  @tparam SizeT unsigned type of size and index,
+ *  uboost::index_type<Size>::type gives the narrowest one
+ *  @tparam Align alignment of element storage, never less than alignof(T).
+ *  Pass uboost::cache_line_size(or SIMD vector size) to align the first
+ *  element for vectorized kernels; the whole object is then padded to
+ *  Align as well so it does not share cache lines with its neighbours
+ */
+template <class T, uint64_t Size, class SizeT=size_type, size_type Align=alignof(T)>
+class vector:public uboost::vector<T, SizeT>
 {
+	static_assert(Size<=SizeT(-1), "vector capacity exceeds its size type");
+
 	public:
 	// constructors
 	explicit vector()
-	:uboost::vector<T>((T*)_physBuf, Size){};
+	:uboost::vector<T, SizeT>((T*)_physBuf, Size){};
 
-	vector(const uboost::vector<T>& x)
+	vector(const vector& x)
 	:vector()
 	{
-	    assign(x.cbegin(), x.cend());
+	    this->assign(x.cbegin(), x.cend());
 	};
-	vector(uboost::vector<T>&& x)
+	vector(const uboost::vector<T, SizeT>& x)
 	:vector()
 	{
-	    assign(move_iterator<typename uboost::vector<T>::iterator>(x.begin()),
-	           move_iterator<typename uboost::vector<T>::iterator>(x.end()));
+	    this->assign(x.cbegin(), x.cend());
+	};
+	vector(uboost::vector<T, SizeT>&& x)
+	:vector()
+	{
+	    this->assign(move_iterator<typename uboost::vector<T, SizeT>::iterator>(x.begin()),
+	                 move_iterator<typename uboost::vector<T, SizeT>::iterator>(x.end()));
         x.clear();
 	};
 	//!!!TODO support constructor variants:
@@ -639,26 +1044,42 @@ class vector:public uboost::vector<T>
     //  vector (InputIterator first, InputIterator last);
     //vector (initializer_list<value_type> il);
 
-    vector& operator=(const uboost::vector<T>& x)
+    vector& operator=(const vector& x)
 	{
-        assign(x.cbegin(), x.cend());
+        this->assign(x.cbegin(), x.cend());
+        return *this;
+	};
+
+    vector& operator=(const uboost::vector<T, SizeT>& x)
+	{
+        this->assign(x.cbegin(), x.cend());
+        return *this;
 	};
 
-	vector& operator=(uboost::vector<T>&& x)
+	vector& operator=(uboost::vector<T, SizeT>&& x)
 	{
-	    assign(move_iterator<typename uboost::vector<T>::iterator>(x.begin()),
-	           move_iterator<typename uboost::vector<T>::iterator>(x.end()));
+	    this->assign(move_iterator<typename uboost::vector<T, SizeT>::iterator>(x.begin()),
+	                 move_iterator<typename uboost::vector<T, SizeT>::iterator>(x.end()));
         x.clear();
+        return *this;
+	};
+
+	template <class E>
+	typename enable_if<E::vector_expression_tag, vector&>::type operator=(const E& e)
+	{
+	    static_assert(E::capacity<=Size, "vector expression is larger than destination");
+	    uboost::vector<T, SizeT>::operator=(e);
+	    return *this;
 	};
 
-	virtual ~vector()
+	~vector()
 	{
 	    // base::~vector() will do contents destruction
 	};
 
 	private:
-	//typedef typename uboost::vector<T>::T_container T_container;
-	uint8_t _physBuf[sizeof(T)*Size];
+	//typedef typename uboost::vector<T, SizeT>::T_container T_container;
+	alignas(T) alignas(Align) uint8_t _physBuf[sizeof(T)*Size];
 };
 
 }// declare
@@ -0,0 +1,189 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "../../include/list.hpp"
+#include "../../include/algorithm/expression.hpp"
+
+using namespace uboost;
+
+namespace
+{
+int violations=0;
+
+void count_violation(const char*, int)
+{
+    violations++;
+}
+}
+
+// report violations instead of trapping, so tests exercising soft failures
+// (e.g. connecting to full signal) also run in checked modes
+void check_test_setup()
+{
+    set_check_handler(&count_violation);
+}
+
+// bulk assignment past capacity is clamped in every mode, and reported
+// unless checks are compiled away
+bool check_vector_assign_test()
+{
+    bool result=true;
+    const int reported=(UBOOST_CHECK_MODE!=UBOOST_CHECK_UNCHECKED)?1:0;
+    declare::vector<int, 3> v;
+    uboost::vector<int>& base=v;
+    const int src[]={1, 2, 3, 4, 5};
+
+    violations=0;
+    v.assign(src, src+5);
+    result&=(v.size()==3 && v[2]==3);
+    result&=(violations==reported);
+
+    declare::listpool<int, 5> pool;
+    list<int> l(pool);
+    l.assign(src, src+5);
+    v.clear();
+    v.assign(l.cbegin(), l.cend());
+    result&=(v.size()==3 && v[2]==3);
+    result&=(violations==2*reported);
+
+    declare::vector<int, 5> big;
+    big.assign(src, src+5);
+    base=big*2;
+    result&=(v.size()==3 && v[2]==6);
+    result&=(violations==3*reported);
+
+    violations=0;
+    return result;
+};
+
+#if UBOOST_CHECK_MODE!=UBOOST_CHECK_UNCHECKED
+
+bool check_vector_test()
+{
+    bool result=true;
+    declare::vector<int, 3> v;
+    v.push_back(1);
+    v.push_back(2);
+
+    violations=0;
+    result&=(v[1]==2);
+    result&=(v.at(0)==1);
+    result&=(violations==0);
+
+    int past=v[2];
+    (void)past;
+    result&=(violations==1);
+
+    // offending insertion is skipped
+    v.push_back(3);
+    v.push_back(4);
+    result&=(violations==2);
+    result&=(v.size()==3);
+    v.insert(v.begin(), 0);
+    result&=(violations==3);
+    result&=(v.size()==3 && v[0]==1);
+    v.emplace_back_n(2, 5);
+    result&=(violations==4);
+
+    v.clear();
+    v.pop_back();
+    result&=(violations==5);
+    result&=(v.size()==0);
+
+    return result;
+};
+
+bool check_list_test()
+{
+    bool result=true;
+    declare::listpool<int, 2> pool;
+    list<int> l(pool);
+    l.push_back(1);
+    l.push_back(2);
+
+    violations=0;
+    l.push_back(3);
+    result&=(violations==1);
+    result&=(l.size()==2);
+
+    l.clear();
+    l.pop_front();
+    result&=(violations==2);
+
+    pool.free(2);
+    result&=(violations==3);
+
+    return result;
+};
+
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+
+bool check_iterator_test()
+{
+    bool result=true;
+    declare::vector<int, 8> v;
+    for(int i=0;i<4;i++)
+        v.push_back(i);
+
+    violations=0;
+    // appending does not move elements
+    vector<int>::iterator it=v.begin()+1;
+    v.push_back(4);
+    result&=(*it==1);
+    result&=(violations==0);
+
+    // erase invalidates, returned iterator is fresh
+    vector<int>::iterator next=v.erase(v.begin());
+    result&=(*next==1);
+    result&=(violations==0);
+    int stale=*it;
+    (void)stale;
+    result&=(violations==1);
+
+    it=v.begin();
+    v.pop_back();
+    result&=(it[0]==1);
+    result&=(violations==2);
+
+    // list only invalidates iterators to erased item
+    declare::listpool<int, 4> pool;
+    list<int> l(pool);
+    l.push_back(1);
+    l.push_back(2);
+    l.push_back(3);
+    list<int>::iterator first=l.begin();
+    list<int>::iterator second=++l.begin();
+    violations=0;
+    l.erase(second);
+    l.push_back(4);
+    result&=(*first==1);
+    result&=(violations==0);
+    int erased=*second;
+    (void)erased;
+    result&=(violations==1);
+
+    return result;
+};
+
+#endif
+
+#endif
+
+bool check_test_main()
+{
+    bool result=true;
+    result&=check_vector_assign_test();
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_UNCHECKED
+    // checks are compiled away
+    result&=(UBOOST_CHECK(false));
+#else
+    result&=check_vector_test();
+    result&=check_list_test();
+#if UBOOST_CHECK_MODE==UBOOST_CHECK_DEBUG
+    result&=check_iterator_test();
+#endif
+    violations=0;
+#endif
+    return result;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "../../include/algorithm/expression.hpp"
+
+using namespace uboost;
+
+bool expression_declared_test()
+{
+    bool result=true;
+    declare::vector<float,16>  a, b, c, out;
+    for(int i=0;i<10;i++)
+    {
+        a.push_back(float(i));
+        b.push_back(float(2*i));
+        c.push_back(1.0f);
+    }
+
+    out=a*2.0f+b-c;
+    result&=(out.size()==10);
+    for(int i=0;i<10;i++)
+        result&=(out[i]==float(4*i-1));
+
+    // destination is one of operands
+    out=0.5f*(out+c)/2;
+    result&=(out.size()==10);
+    for(int i=0;i<10;i++)
+        result&=(out[i]==float(i));
+
+    // shrinking destination
+    out.push_back(0);
+    out=c-a;
+    result&=(out.size()==10);
+    result&=(out[9]==-8.0f);
+
+    // plain copy still works
+    out=a;
+    result&=(out.size()==10);
+    result&=(out[9]==9.0f);
+    return result;
+}
+
+static void filter_stage(vector<int32_t>& out, const vector<int32_t>& x,
+                         const vector<int32_t>& y, int32_t k)
+{
+    // capacity is unknown through uboost::vector, size is checked at runtime
+    out=x*k-y;
+}
+
+bool expression_reference_test()
+{
+    bool result=true;
+    declare::vector<int32_t,8>   x, y;
+    declare::vector<int32_t,32>  out;
+    for(int i=0;i<8;i++)
+    {
+        x.push_back(i);
+        y.push_back(i*i);
+    }
+    filter_stage(out, x, y, 3);
+    result&=(out.size()==8);
+    for(int i=0;i<8;i++)
+        result&=(out[i]==3*i-i*i);
+    return result;
+}
+
+bool expression_mixed_capacity_test()
+{
+    bool result=true;
+    declare::vector<int16_t,16>  small;
+    declare::vector<int16_t,64>  large;
+    // only as large as the smaller operand
+    declare::vector<int16_t,16>  out;
+    for(int i=0;i<10;i++)
+    {
+        small.push_back(i);
+        large.push_back(2*i);
+    }
+    static_assert(decltype(small+large)::capacity==16, "");
+    out=large-small*2+large;
+    result&=(out.size()==10);
+    for(int i=0;i<10;i++)
+        result&=(out[i]==2*i);
+    return result;
+}
+
+bool expression_test_main()
+{
+    bool result=true;
+    result&=expression_declared_test();
+    result&=expression_reference_test();
+    result&=expression_mixed_capacity_test();
+    return result;
+}
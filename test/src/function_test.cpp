@@ -0,0 +1,379 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+
+using namespace uboost;
+
+namespace
+{
+int free_function(int a, int b)
+{
+    return a+b;
+};
+
+struct counted
+{
+    counted(int* c):alive(c){(*alive)++;};
+    counted(const counted& x):alive(x.alive){(*alive)++;};
+    ~counted(){(*alive)--;};
+    int* alive;
+};
+
+struct copy_counter
+{
+    copy_counter(int* c, int* m):copies(c),moves(m){};
+    copy_counter(const copy_counter& x):copies(x.copies),moves(x.moves){(*copies)++;};
+    copy_counter(copy_counter&& x):copies(x.copies),moves(x.moves){(*moves)++;};
+    int* copies;
+    int* moves;
+};
+
+struct handler_base
+{
+    handler_base(int b):base(b){};
+    int offset(int a) const {return a+base;};
+    virtual int scale(int a){return a*base;};
+    int base;
+};
+
+struct handler:public handler_base
+{
+    handler(int b):handler_base(b),events(0){};
+    void on_event(int a){events+=a;};
+    virtual int scale(int a){return a*base*2;};
+    int events;
+};
+
+// work item owning a move-only resource
+struct owning_task
+{
+    owning_task(int val):res(new int(val)){};
+    owning_task(const owning_task&)=delete;
+    owning_task(owning_task&& x):res(x.res){x.res=nullptr;};
+    ~owning_task(){delete res;};
+    int operator()(int a){return *res+a;};
+    int* res;
+};
+}
+
+bool function_basic_test()
+{
+    bool result=true;
+    int k=10;
+
+    function<int(int,int)> f1(&free_function);
+    result&=(f1(1,2)==3);
+
+    function<int(int)> f2([k](int a){return a*k;});
+    result&=(f2(2)==20);
+
+    // non-const lvalue copy must not be wrapped by generic constructor
+    function<int(int)> f3(f2);
+    result&=(f3(3)==30);
+
+    function<int(int)> f4(move(f3));
+    result&=(f4(4)==40);
+
+    f3=f4;
+    result&=(f3(5)==50);
+
+    function<int(int)> empty;
+    function<int(int)> empty2(empty);
+    f3=empty2;
+
+    return result;
+};
+
+bool function_inline_bytes_test()
+{
+    bool result=true;
+    int a=1, b=2;
+
+    // per-instance capacity: one pointer is enough for this callable
+    function<int(), sizeof(void*)> small([&a](){return a;});
+    result&=(small()==1);
+    result&=(sizeof(small)<sizeof(function<int()>));
+
+    function<int(), sizeof(void*)> small2(small);
+    a=5;
+    result&=(small2()==5);
+
+    // fits default capacity
+    function<int()> normal([&a, &b](){return a+b;});
+    result&=(normal()==7);
+
+    return result;
+};
+
+bool function_layout_test()
+{
+    bool result=true;
+    int calls=0;
+
+    // whole InlineBytes is payload, plus invoker and manager pointer
+    result&=(sizeof(function<void(), sizeof(void*)>)==3*sizeof(void*));
+
+    // mutable capture lives in the inline buffer and persists between calls
+    function<int()> counter([calls]() mutable {return ++calls;});
+    result&=(counter()==1);
+    result&=(counter()==2);
+    result&=(calls==0);
+
+    function<void()> by_ref([&calls](){calls++;});
+    by_ref();
+    result&=(calls==1);
+    by_ref();
+    result&=(calls==2);
+
+    function<int(int,int,int,int,int,int,int,int,int)> sum9(
+        [](int a,int b,int c,int d,int e,int f,int g,int h,int i)
+        {return a+b+c+d+e+f+g+h+i;});
+    result&=(sum9(1,2,3,4,5,6,7,8,9)==45);
+
+    return result;
+};
+
+bool function_move_test()
+{
+    bool result=true;
+    int copies=0, moves=0;
+    int alive=0;
+
+    {
+        copy_counter cc(&copies, &moves);
+        counted cnt(&alive);
+        function<int()> f1([cc, cnt](){return *cnt.alive;});
+        copies=0;
+        moves=0;
+
+        // move should never clone captured state
+        function<int()> f2(move(f1));
+        function<int()> f3;
+        f3=move(f2);
+        result&=(copies==0);
+        result&=(moves==2);
+        result&=(f3()==2);
+
+        function<int()> f4(f3);
+        result&=(copies==1);
+        result&=(alive==3);
+    }
+    result&=(alive==0);
+
+    // trivially copyable captures are relocated as plain bytes
+    int a=3, b=4;
+    function<int()> t1([a, b](){return a*b;});
+    function<int()> t2(move(t1));
+    function<int()> t3(t2);
+    result&=(t2()==12);
+    result&=(t3()==12);
+
+    return result;
+};
+
+bool unique_function_test()
+{
+    bool result=true;
+
+    unique_function<int(int)> u1(owning_task(5));
+    result&=(u1(1)==6);
+
+    unique_function<int(int)> u2(move(u1));
+    result&=(!u1);
+    result&=(u2(2)==7);
+
+    unique_function<int(int)> u3;
+    result&=(!u3);
+    u3=move(u2);
+    result&=(u3(3)==8);
+
+    // spill into pool and hand it over without copying
+    declare::function_pool<32, 1> pool;
+    unique_function<int(int), sizeof(void*)> u4(owning_task(1), pool);
+    result&=(pool.size()==0);
+    int a=1, b=2, c=3;
+    unique_function<int(int), sizeof(void*)> u5([a, b, c](int d){return a+b+c+d;}, pool);
+    result&=(pool.size()==1);
+    unique_function<int(int), sizeof(void*)> u6(move(u5));
+    result&=(u6(3)==9);
+    result&=(pool.size()==1);
+    u6=move(u4);
+    result&=(pool.size()==0);
+    result&=(u6(1)==2);
+
+    return result;
+};
+
+namespace
+{
+int apply_twice(function_ref<int(int)> fn, int val)
+{
+    return fn(fn(val));
+};
+}
+
+bool function_ref_test()
+{
+    bool result=true;
+    int k=3, calls=0;
+
+    result&=(sizeof(function_ref<int(int)>)==2*sizeof(void*));
+
+    auto triple=[k](int a){return a*k;};
+    result&=(apply_twice(triple, 1)==9);
+    result&=(apply_twice([](int a){return a+1;}, 1)==3);
+
+    // referenced object is not copied, its state is shared
+    auto counter=[&calls](int a) mutable {calls++; return a;};
+    function_ref<int(int)> r(counter);
+    r(0);
+    r(0);
+    result&=(calls==2);
+
+    auto sum=[](int a, int b){return a+b;};
+    function_ref<int(int,int)> fp(free_function);
+    function_ref<int(int,int)> fp2(&free_function);
+    function_ref<int(int,int)> lr(sum);
+    result&=(fp(1,2)==3);
+    result&=(fp2(2,3)==5);
+    result&=(lr(3,4)==7);
+
+    function<int(int)> f(triple);
+    result&=(apply_twice(f, 2)==18);
+
+    function_ref<int(int)> copy=r;
+    copy(0);
+    result&=(calls==3);
+
+    return result;
+};
+
+bool function_member_test()
+{
+    bool result=true;
+    handler h(3);
+    const handler& ch=h;
+
+    // bound to object
+    function<void(int)> f1(h, &handler::on_event);
+    function<void(int)> f2(&h, &handler::on_event);
+    f1(2);
+    f2(5);
+    result&=(h.events==7);
+
+    function<int(int)> f3(ch, &handler_base::offset);
+    result&=(f3(1)==4);
+
+    // virtual member dispatch follows dynamic type
+    handler_base& hb=h;
+    function<int(int)> f4(hb, &handler_base::scale);
+    result&=(f4(2)==12);
+
+    unique_function<int(int)> u1(h, &handler_base::offset);
+    result&=(u1(2)==5);
+
+    // pointer to member with object as first argument
+    function<void(handler&, int)> f5(&handler::on_event);
+    f5(h, 1);
+    result&=(h.events==8);
+
+    function<int(const handler*, int)> f6(&handler_base::offset);
+    result&=(f6(&h, 10)==13);
+
+    function<int(handler_base&, int)> f7(&handler_base::scale);
+    result&=(f7(h, 1)==6);
+
+    return result;
+};
+
+bool function_pool_test()
+{
+    bool result=true;
+    int a=1, b=2, c=3, d=4, e=5;
+    int alive=0;
+    declare::function_pool<64, 2> pool;
+
+    {
+        counted cnt(&alive);
+        // oversize: spilled into pool
+        function<int(), sizeof(void*)> big([&a, &b, &c, &d, &e, cnt](){return a+b+c+d+e;},
+                                           pool);
+        result&=(big()==15);
+        result&=(pool.size()==1);
+
+        // copy claims another block
+        function<int(), sizeof(void*)> big2(big);
+        result&=(big2()==15);
+        result&=(pool.size()==2);
+        result&=(pool.free()==0);
+
+        // moving spilled object only moves block pointer
+        function<int(), sizeof(void*)> big3(move(big2));
+        result&=(big3()==15);
+        result&=(pool.size()==2);
+        big2=move(big3);
+
+        // fits inline, pool untouched
+        function<int(), sizeof(void*)> small([&a](){return a;}, pool);
+        result&=(small()==1);
+        result&=(pool.size()==2);
+
+        big2=small;
+        result&=(pool.size()==1);
+        result&=(big2()==1);
+    }
+    result&=(pool.size()==0);
+    result&=(alive==0);
+
+    return result;
+};
+
+bool function_pool_exhausted_test()
+{
+    bool result=true;
+    int a=1, b=2, c=3, d=4, e=5;
+    int alive=0;
+    declare::function_pool<64, 1> pool;
+    declare::function_pool<8, 1> tiny;
+
+    {
+        counted cnt(&alive);
+        auto big=[&a, &b, &c, &d, &e, cnt](){return a+b+c+d+e;};
+        function<int(), sizeof(void*)> f1(big, pool);
+        result&=(bool(f1) && f1()==15);
+
+        // no block left, function stays empty
+        function<int(), sizeof(void*)> f2(big, pool);
+        result&=(!f2);
+        unique_function<int(), sizeof(void*)> u(big, pool);
+        result&=(!u);
+        function<int(), sizeof(void*)> f3(f1);
+        result&=(!f3);
+        result&=(pool.size()==1);
+
+        // block size only known at runtime
+        uboost::function_pool& small=tiny;
+        function<int(), sizeof(void*)> f4(big, small);
+        result&=(!f4);
+        result&=(tiny.size()==0);
+    }
+    result&=(pool.size()==0);
+    result&=(alive==0);
+
+    return result;
+};
+
+bool function_test_main()
+{
+    bool result=true;
+    result&=function_basic_test();
+    result&=function_inline_bytes_test();
+    result&=function_layout_test();
+    result&=function_move_test();
+    result&=unique_function_test();
+    result&=function_ref_test();
+    result&=function_member_test();
+    result&=function_pool_test();
+    result&=function_pool_exhausted_test();
+    return result;
+}
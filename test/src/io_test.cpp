@@ -0,0 +1,137 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "../../include/io.hpp"
+
+using namespace uboost;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>
+#include <fcntl.h>
+
+bool io_uninitialized_test()
+{
+    bool result=true;
+    declare::vector<uint8_t, 16> v;
+
+    v.push_back(1);
+    uint8_t* p=v.append_uninitialized(3);
+    result&=(p==v.data()+1);
+    result&=(v.size()==4);
+    p[0]=2;p[1]=3;p[2]=4;
+    result&=(v[3]==4);
+
+    v.resize_for_overwrite(2);
+    result&=(v.size()==2);
+    result&=(v[1]==2);
+    v.resize_for_overwrite(16);
+    result&=(v.size()==16);
+
+    return result;
+};
+
+bool io_pipe_test()
+{
+    bool result=true;
+    int fds[2];
+    if(pipe(fds)!=0)
+        return false;
+
+    declare::vector<uint8_t, 4> head;
+    declare::vector<uint8_t, 8> body;
+    head.push_back('h');
+    head.push_back('i');
+    body.assign(5, 'x');
+    result&=(io::writev(fds[1], head, body)==7);
+
+    // only capacity left is filled, read is committed by size
+    declare::vector<uint8_t, 5> in;
+    in.push_back('>');
+    result&=(io::read(fds[0], in)==4);
+    result&=(in.size()==5);
+    result&=(in[1]=='h' && in[2]=='i' && in[4]=='x');
+    result&=(io::read(fds[0], in)==0);
+
+    // partial read only commits what is available
+    declare::vector<uint8_t, 16> rest;
+    result&=(io::read(fds[0], rest, 2)==2);
+    result&=(rest.size()==2);
+    result&=(io::read(fds[0], rest)==1);
+    result&=(rest.size()==3);
+
+    // wider elements are committed only when complete
+    declare::vector<uint32_t, 4> words;
+    words.push_back(0x01020304);
+    words.push_back(0x05060708);
+    result&=(io::writev(fds[1], words)==8);
+    close(fds[1]);
+    declare::vector<uint32_t, 4> wordsIn;
+    io::remainder rest4;
+    result&=(io::read(fds[0], wordsIn, rest4)==2);
+    result&=(wordsIn.size()==2 && wordsIn[1]==0x05060708);
+    result&=(io::read(fds[0], wordsIn, rest4)==0);
+    result&=(wordsIn.size()==2);
+    close(fds[0]);
+
+    // error keeps vector untouched
+    result&=(io::read(-1, wordsIn, rest4)==-1);
+    result&=(wordsIn.size()==2);
+
+    return result;
+};
+
+bool io_partial_test()
+{
+    bool result=true;
+    int fds[2];
+    if(pipe(fds)!=0)
+        return false;
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL)|O_NONBLOCK);
+
+    // element and a half, the half is kept for next call
+    const uint8_t bytes[]={1, 0, 0, 0, 2, 0, 3, 0, 4, 0, 0, 0};
+    declare::vector<uint32_t, 8> v;
+    io::remainder rest;
+    result&=(write(fds[1], bytes, 6)==6);
+    result&=(io::read(fds[0], v, rest)==1);
+    result&=(v.size()==1 && v[0]==1);
+    result&=(rest.bytes==2);
+
+    // nothing complete yet, bytes are not lost
+    result&=(io::read(fds[0], v, rest)==-1 && errno==EAGAIN);
+    result&=(v.size()==1 && rest.bytes==2);
+
+    result&=(write(fds[1], bytes+6, 6)==6);
+    result&=(io::read(fds[0], v, rest)==2);
+    result&=(v.size()==3 && v[1]==2+(3<<16) && v[2]==4);
+    result&=(rest.bytes==0);
+
+    // truncated element at end of file stays past the last one
+    result&=(write(fds[1], bytes, 1)==1);
+    close(fds[1]);
+    result&=(io::read(fds[0], v, rest)==0);
+    result&=(v.size()==3 && rest.bytes==1);
+    result&=(reinterpret_cast<const uint8_t*>(v.data()+v.size())[0]==1);
+    close(fds[0]);
+    return result;
+};
+
+bool io_test_main()
+{
+    bool result=true;
+    result&=io_uninitialized_test();
+    result&=io_pipe_test();
+    result&=io_partial_test();
+    return result;
+}
+
+#else
+
+bool io_test_main()
+{
+    return true;
+}
+
+#endif
@@ -0,0 +1,552 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/list.hpp"
+#include "../../include/algorithm/parallel.hpp"
+
+using namespace uboost;
+
+namespace
+{
+// From converts implicitly to To
+template <class From, class To>
+struct converts
+{
+    static char probe(To);
+    static long probe(...);
+    static const bool value=(sizeof(probe(*static_cast<From*>(nullptr)))==sizeof(char));
+};
+}
+
+static bool list_equal(const list<int>& l, const int* expected, size_type n)
+{
+    bool result=(l.size()==n);
+    size_type i=0;
+    for(auto it=l.cbegin();it!=l.cend()&&i<n;++it)
+        result&=(*it==expected[i++]);
+    result&=(i==n);
+    // walk backward as well to check prev links
+    for(auto it=l.crbegin();it!=l.crend()&&i>0;++it)
+        result&=(*it==expected[--i]);
+    result&=(i==0);
+    return result;
+}
+
+bool list_push_pop_test()
+{
+    bool result=true;
+    declare::listpool<int,8> pool;
+    list<int> l(pool);
+
+    l.push_back(1);
+    l.push_back(2);
+    l.push_front(0);
+    const int e1[]={0, 1, 2};
+    result&=list_equal(l, e1, 3);
+    result&=(pool.size()==3);
+
+    l.pop_front();
+    l.pop_back();
+    result&=(l.front()==1);
+    result&=(l.back()==1);
+    result&=(pool.size()==1);
+
+    l.clear();
+    result&=l.empty();
+    result&=(pool.size()==0);
+
+    // const_iterator never gives write access back
+    static_assert(converts<list<int>::iterator, list<int>::const_iterator>::value, "");
+    static_assert(!converts<list<int>::const_iterator, list<int>::iterator>::value, "");
+    return result;
+}
+
+bool list_insert_erase_test()
+{
+    bool result=true;
+    declare::listpool<int,16> pool;
+    list<int> l(pool);
+
+    for(int i=0;i<4;i++)
+        l.push_back(i);
+    auto it=l.insert(++l.cbegin(), 2, 9);
+    result&=(*it==9);
+    it=l.emplace(l.cend(), 4);
+    result&=(*it==4);
+    const int e1[]={0, 9, 9, 1, 2, 3, 4};
+    result&=list_equal(l, e1, 7);
+
+    it=l.erase(++l.cbegin(), l.cbegin()+3);
+    result&=(*it==1);
+    it=l.erase(l.cend()-1);
+    result&=(it==l.end());
+    const int e2[]={0, 1, 2, 3};
+    result&=list_equal(l, e2, 4);
+
+    l.resize(6, 5);
+    l.resize(5);
+    const int e3[]={0, 1, 2, 3, 5};
+    result&=list_equal(l, e3, 5);
+    result&=(pool.size()==5);
+    return result;
+}
+
+bool list_splice_test()
+{
+    bool result=true;
+    declare::listpool<int,16> pool;
+    list<int> l(pool), m(pool);
+
+    for(int i=0;i<3;i++)
+    {
+        l.push_back(i);
+        m.push_back(10+i);
+    }
+
+    l.splice(++l.cbegin(), m, ++m.cbegin());
+    const int e1[]={0, 11, 1, 2};
+    result&=list_equal(l, e1, 4);
+
+    l.splice(l.cend(), m);
+    result&=m.empty();
+    const int e2[]={0, 11, 1, 2, 10, 12};
+    result&=list_equal(l, e2, 6);
+
+    m.splice(m.cend(), l, l.cbegin(), l.cbegin()+2);
+    const int e3[]={0, 11};
+    result&=list_equal(m, e3, 2);
+    result&=(l.size()==4);
+    result&=(pool.size()==6);
+    return result;
+}
+
+bool list_index_type_test()
+{
+    bool result=true;
+    static_assert(is_same<index_type<200>::type, uint8_t>::value, "");
+    static_assert(is_same<index_type<300000>::type, uint32_t>::value, "");
+
+    // narrow links for small pool, one value is kept as null link
+    typedef index_type<200+1>::type idx_t;
+    static_assert(sizeof(declare::listpool<int,200,idx_t>::item_type)<
+                  sizeof(declare::listpool<int,200,uint32_t>::item_type), "");
+
+    declare::listpool<int,200,idx_t> pool;
+    list<int,idx_t> l(pool);
+    for(int i=0;i<200;i++)
+        l.push_back(i);
+    result&=(l.size()==200);
+    result&=(pool.free()==0);
+    result&=(l.back()==199);
+    result&=(*(--l.end())==199);
+    result&=(distance(l.begin(), l.end())==200);
+    result&=(*(l.cbegin()+150)==150);
+    result&=(*(l.cend()-150)==50);
+    l.clear();
+    result&=(pool.free()==200);
+
+    declare::listpool<double,4,idx_t,cache_line_size> dpool;
+    list<double,idx_t> dl(dpool);
+    dl.push_back(1.5);
+    result&=((uintptr_t)&dl.front()%cache_line_size==0);
+
+    // boundary of one byte links
+    static_assert(is_same<index_type<254+1>::type, uint8_t>::value, "");
+    static_assert(is_same<index_type<255+1>::type, uint16_t>::value, "");
+    declare::listpool<int,254,index_type<254+1>::type> full8;
+    list<int,uint8_t> l8(full8);
+    declare::listpool<int,255,index_type<255+1>::type> full16;
+    list<int,uint16_t> l16(full16);
+    for(int i=0;i<255;i++)
+    {
+        if(i<254)
+            l8.push_back(i);
+        l16.push_back(i);
+    }
+    result&=(l8.size()==254 && l8.back()==253 && full8.free()==0);
+    result&=(l16.size()==255 && l16.back()==254);
+    return result;
+}
+
+bool list_range_test()
+{
+    bool result=true;
+    declare::listpool<int,2048> pool;
+    list<int> l(pool), m(pool);
+
+    // end() is the list head, so scanning loop is linear
+    l.resize(2000, 7);
+    result&=(l.size()==2000);
+    result&=(pool.size()==2000);
+    int count=0;
+    for(auto it=l.begin();it!=l.end();++it)
+        count+=(*it==7);
+    result&=(count==2000);
+
+    // shrink and range erase return the whole range to pool at once
+    l.resize(10);
+    result&=(l.size()==10);
+    result&=(pool.size()==10);
+    l.clear();
+    for(int i=0;i<10;i++)
+        l.push_back(i);
+    auto it=l.erase(l.cbegin()+2, l.cbegin()+8);
+    result&=(*it==8);
+    const int e1[]={0, 1, 8, 9};
+    result&=list_equal(l, e1, 4);
+    result&=(pool.size()==4);
+
+    // freed items are claimed again
+    l.insert(l.cbegin()+2, 3, 5);
+    const int e2[]={0, 1, 5, 5, 5, 8, 9};
+    result&=list_equal(l, e2, 7);
+    result&=(pool.size()==7);
+
+    // range splice, within list and between lists
+    l.splice(l.cbegin(), l, l.cbegin()+5, l.cend());
+    const int e3[]={8, 9, 0, 1, 5, 5, 5};
+    result&=list_equal(l, e3, 7);
+    m.push_back(100);
+    m.splice(m.cbegin(), l, l.cbegin()+2, l.cbegin()+4);
+    const int e4[]={0, 1, 100};
+    result&=list_equal(m, e4, 3);
+    const int e5[]={8, 9, 5, 5, 5};
+    result&=list_equal(l, e5, 5);
+
+    l.assign(2, 3);
+    const int e6[]={3, 3};
+    result&=list_equal(l, e6, 2);
+    m.assign(l.cbegin(), l.cend());
+    result&=list_equal(m, e6, 2);
+    result&=(pool.size()==4);
+    return result;
+}
+
+namespace
+{
+// neither copyable nor movable, so it can only be relinked
+struct pinned
+{
+    pinned(int _key, int _order):key(_key),order(_order){};
+    pinned(const pinned&)=delete;
+    pinned(pinned&&)=delete;
+    bool operator<(const pinned& x) const{return key<x.key;};
+    int key;
+    int order;
+};
+}
+
+bool list_algorithm_test()
+{
+    bool result=true;
+    declare::listpool<int,64> pool;
+    list<int> l(pool), m(pool);
+
+    const int src[]={5, 3, 9, 1, 3, 7, 2, 8, 3};
+    l.assign(src, src+9);
+    l.sort();
+    const int e1[]={1, 2, 3, 3, 3, 5, 7, 8, 9};
+    result&=list_equal(l, e1, 9);
+
+    l.unique();
+    const int e2[]={1, 2, 3, 5, 7, 8, 9};
+    result&=list_equal(l, e2, 7);
+
+    const int msrc[]={0, 3, 4, 10};
+    m.assign(msrc, msrc+4);
+    l.merge(m);
+    result&=m.empty();
+    const int e3[]={0, 1, 2, 3, 3, 4, 5, 7, 8, 9, 10};
+    result&=list_equal(l, e3, 11);
+
+    l.remove_if([](int v){return v%2!=0;});
+    const int e4[]={0, 2, 4, 8, 10};
+    result&=list_equal(l, e4, 5);
+    l.remove(4);
+    l.reverse();
+    const int e5[]={10, 8, 2, 0};
+    result&=list_equal(l, e5, 4);
+
+    l.sort([](int a, int b){return a>b;});
+    result&=list_equal(l, e5, 4);
+    // removing by reference to its own item
+    l.push_back(8);
+    l.remove(l.front()==10?*(++l.begin()):l.front());
+    const int e6[]={10, 2, 0};
+    result&=list_equal(l, e6, 3);
+    result&=(pool.size()==3);
+
+    // larger sort against insertion order
+    l.clear();
+    uint32_t seed=1;
+    for(int i=0;i<60;i++)
+    {
+        seed=seed*1103515245+12345;
+        l.push_back(int((seed>>16)%100));
+    }
+    l.sort();
+    int prev=-1;
+    size_type n=0;
+    for(auto it=l.cbegin();it!=l.cend();++it, n++)
+    {
+        result&=(prev<=*it);
+        prev=*it;
+    }
+    result&=(n==60);
+    result&=(*l.crbegin()==prev);
+
+    // payloads stay in place, sort is stable
+    declare::listpool<pinned,8> ppool;
+    list<pinned> p(ppool);
+    const int keys[]={3, 1, 2, 1, 3};
+    for(int i=0;i<5;i++)
+        p.emplace_back(keys[i], i);
+    const pinned* addr=&p.front();
+    p.sort();
+    const int order[]={1, 3, 2, 0, 4};
+    int i=0;
+    for(auto it=p.cbegin();it!=p.cend();++it)
+        result&=(it->order==order[i++]);
+    result&=(&*(p.cbegin()+3)==addr);
+    return result;
+}
+
+bool list_physical_order_test()
+{
+    bool result=true;
+    declare::listpool<int,100> pool;
+    list<int> l(pool), m(pool);
+
+    for(int i=0;i<70;i++)
+        l.push_front(i);
+    for(int i=0;i<20;i++)
+        m.push_back(100+i);
+    l.remove_if([](int v){return v%3==0;});
+    result&=(pool.occupied(l.begin().get_idx()));
+    result&=(!pool.occupied(99));
+
+    // every live item of the pool, in array order
+    int count=0, total=0;
+    pool.for_each([&count, &total](int& v){count++;total+=v;});
+    int expected=0;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+        expected+=*it;
+    for(auto it=m.cbegin();it!=m.cend();++it)
+        expected+=*it;
+    result&=(count==int(pool.size()));
+    result&=(total==expected);
+
+    // part of the pool only, across bitmap words
+    int partial=0;
+    pool.for_each_range(30, 70, [&partial](int&){partial++;});
+    int occupied=0;
+    for(int i=30;i<70;i++)
+        occupied+=pool.occupied(i);
+    result&=(partial==occupied);
+
+#if defined(__unix__) || defined(__APPLE__)
+    declare::listpool<int,1000> big;
+    list<int> b(big);
+    for(int i=0;i<900;i++)
+        b.push_back(i);
+    b.remove_if([](int v){return v%7==0;});
+    parallel_for_each(big, [](int& v){v*=2;}, 4);
+    int i=0;
+    for(auto it=b.cbegin();it!=b.cend();++it, ++i)
+    {
+        if(i%7==0)
+            i++;
+        result&=(*it==2*i);
+    }
+#endif
+    return result;
+}
+
+namespace
+{
+// counts live objects to catch leaked or doubly destroyed payloads
+struct tracked
+{
+    tracked(int _v, int* _alive):v(_v),alive(_alive){(*alive)++;};
+    tracked(tracked&& x):v(x.v),alive(x.alive){(*alive)++;};
+    tracked& operator=(tracked&& x){v=x.v;alive=x.alive;return *this;};
+    ~tracked(){(*alive)--;};
+    int v;
+    int* alive;
+};
+
+template <class L>
+bool in_array_order(const L& l, size_type first)
+{
+    bool result=true;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+        result&=(it.get_idx()==first++);
+    return result;
+}
+}
+
+bool list_compact_test()
+{
+    bool result=true;
+    int alive=0;
+    declare::listpool<tracked,64> pool;
+    list<tracked> l(pool), m(pool);
+
+    // churn so claim order no longer follows list order
+    for(int i=0;i<40;i++)
+    {
+        if(i%3)
+            l.emplace_front(i, &alive);
+        else
+            m.emplace_back(i, &alive);
+    }
+    l.remove_if([](const tracked& t){return t.v%4==0;});
+    for(int i=40;i<50;i++)
+        l.emplace(++l.cbegin(), i, &alive);
+    m.pop_front();
+
+    int before[64], mbefore[64];
+    int n=0, mn=0, i=0;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+        before[n++]=it->v;
+    for(auto it=m.cbegin();it!=m.cend();++it)
+        mbefore[mn++]=it->v;
+    result&=(!in_array_order(l, 0));
+
+    // leaving a list out is refused, nothing is moved
+    size_type idx_before[64];
+    i=0;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+        idx_before[i++]=it.get_idx();
+    result&=(!pool.compact(l));
+    i=0;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+        result&=(it.get_idx()==idx_before[i++] && it->v==before[i-1]);
+
+    // incremental steps handle at most k items each and resume where
+    // previous one stopped
+    int steps=0;
+    while(!pool.compact_step(4, l, m))
+        steps++;
+    result&=(steps>=(n+mn)/4-1);
+    result&=in_array_order(l, 0);
+    result&=in_array_order(m, l.size());
+
+    i=0;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+        result&=(it->v==before[i++]);
+    result&=(i==n);
+    i=0;
+    for(auto it=m.crbegin();it!=m.crend();++it)
+        result&=(it->v==mbefore[mn-1-i++]);
+    result&=(i==mn);
+    result&=(alive==n+mn);
+
+    // free items are claimed in array order afterwards
+    m.emplace_back(100, &alive);
+    result&=((--m.end()).get_idx()==size_type(n+mn));
+    result&=pool.compact(l, m);
+
+    // lists modified between steps make next step start over
+    l.reverse();
+    result&=(!pool.compact_step(2, l, m));
+    m.pop_front();
+    l.emplace_front(101, &alive);
+    while(!pool.compact_step(2, l, m));
+    result&=in_array_order(l, 0);
+    result&=in_array_order(m, l.size());
+    result&=(l.front().v==101);
+
+    l.clear();
+    m.clear();
+    result&=(alive==0);
+    return result;
+}
+
+namespace
+{
+// large record, links of its pool are better kept apart
+struct message
+{
+    message(uint32_t _id):id(_id)
+    {
+        for(size_type i=0;i<sizeof(body);i++)
+            body[i]=uint8_t(_id+i);
+    };
+    bool operator<(const message& x) const{return id<x.id;};
+    bool intact() const
+    {
+        bool result=true;
+        for(size_type i=0;i<sizeof(body);i++)
+            result&=(body[i]==uint8_t(id+i));
+        return result;
+    };
+    uint32_t id;
+    uint8_t body[252];
+};
+}
+
+bool list_split_layout_test()
+{
+    bool result=true;
+    typedef declare::listpool_split<message,64> pool_type;
+    static_assert(is_same<pool_type::list_type, list<message,size_type,split_layout> >::value, "");
+    static_assert(sizeof(pool_type::item_type)==sizeof(message), "");
+    static_assert(sizeof(declare::listpool<message,64>::item_type)>sizeof(message), "");
+
+    pool_type pool;
+    pool_type::list_type l(pool), m(pool);
+
+    // contents are packed in their own array
+    l.emplace_back(0);
+    l.emplace_back(1);
+    result&=(&pool[1].get()==&pool[0].get()+1);
+    l.clear();
+
+    for(uint32_t i=0;i<20;i++)
+        l.emplace_front(i);
+    m.splice(m.cend(), l, l.cbegin()+5, l.cbegin()+15);
+    result&=(l.size()==10 && m.size()==10);
+    result&=(m.front().id==14 && m.back().id==5);
+    l.erase(l.cbegin(), l.cbegin()+2);
+    l.insert(l.cend(), 2, message(30));
+    l.merge(m);
+    l.sort();
+    l.unique([](const message& a, const message& b){return a.id==b.id;});
+    result&=(l.size()==19);
+    uint32_t prev=0;
+    for(auto it=l.cbegin();it!=l.cend();++it)
+    {
+        result&=(prev<=it->id && it->intact());
+        prev=it->id;
+    }
+    l.reverse();
+    result&=(l.front().id==30 && l.back().id==0);
+
+    uint32_t total=0;
+    pool.for_each([&total](message& x){total+=x.id;});
+    uint32_t expected=0;
+    for(auto it=l.crbegin();it!=l.crend();++it)
+        expected+=it->id;
+    result&=(total==expected);
+
+    result&=pool.compact(l, m);
+    result&=in_array_order(l, 0);
+    result&=(l.front().id==30 && (++l.cbegin())->intact());
+    return result;
+}
+
+bool list_test_main()
+{
+    bool result=true;
+    result&=list_push_pop_test();
+    result&=list_insert_erase_test();
+    result&=list_splice_test();
+    result&=list_index_type_test();
+    result&=list_range_test();
+    result&=list_algorithm_test();
+    result&=list_physical_order_test();
+    result&=list_compact_test();
+    result&=list_split_layout_test();
+    return result;
+}
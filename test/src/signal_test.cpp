@@ -0,0 +1,136 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/signal.hpp"
+
+using namespace uboost;
+
+namespace
+{
+struct observer
+{
+    observer():total(0){};
+    void on_value(int v){total+=v;};
+    int total;
+};
+
+void notify(signal<void(int)>& sig, int v)
+{
+    sig.emit(v);
+};
+}
+
+bool signal_connect_test()
+{
+    bool result=true;
+    declare::signal<void(int), 4> sig;
+    int sum=0, calls=0;
+    observer obs;
+
+    signal_connection c1=sig.connect([&sum](int v){sum+=v;});
+    signal_connection c2=sig.connect([&calls](int){calls++;});
+    signal_connection c3=sig.connect(obs, &observer::on_value);
+    result&=(sig.size()==3);
+    result&=(sig.connected(c2));
+
+    notify(sig, 5);
+    result&=(sum==5);
+    result&=(calls==1);
+    result&=(obs.total==5);
+
+    sig.disconnect(c2);
+    result&=(!c2.valid());
+    result&=(sig.size()==2);
+    sig(2);
+    result&=(sum==7);
+    result&=(calls==1);
+    result&=(obs.total==7);
+
+    // capacity exhausted
+    sig.connect([](int){});
+    sig.connect([](int){});
+    result&=(!sig.connect([](int){}).valid());
+
+    sig.disconnect_all();
+    result&=(sig.empty());
+    result&=(!sig.connected(c1));
+    result&=(!sig.connected(c3));
+
+    return result;
+};
+
+bool signal_reentrancy_test()
+{
+    bool result=true;
+    struct context
+    {
+        declare::signal<void(int), 8> sig;
+        signal_connection self, other, late;
+        int self_calls, other_calls, late_calls;
+        bool ok;
+    } c;
+    int order=0, first=0;
+    c.self_calls=c.other_calls=c.late_calls=0;
+    c.ok=true;
+
+    c.sig.connect([&order, &first](int){first=++order;});
+    // disconnects itself and the following slot while emitting
+    c.self=c.sig.connect([&c](int)
+    {
+        c.self_calls++;
+        c.sig.disconnect(c.self);
+        c.sig.disconnect(c.other);
+        c.late=c.sig.connect([&c](int){c.late_calls++;});
+        c.ok&=(c.sig.size()==4);
+    });
+    c.other=c.sig.connect([&c](int){c.other_calls++;});
+
+    c.sig.emit(0);
+    result&=c.ok;
+    result&=(first==1);
+    result&=(c.self_calls==1);
+    result&=(c.other_calls==0);
+    result&=(c.late_calls==0);
+    result&=(c.sig.size()==2);
+
+    c.sig.emit(0);
+    result&=(first==2);
+    result&=(c.self_calls==1);
+    result&=(c.late_calls==1);
+
+    return result;
+};
+
+bool signal_id_wrap_test()
+{
+    bool result=true;
+    declare::signal<void(int), 4> sig;
+    int kept=0, others=0;
+
+    // long-lived connection outlives a full round of ids
+    signal_connection keep=sig.connect([&kept](int){kept++;});
+    for(int i=0;i<65535;i++)
+    {
+        signal_connection c=sig.connect([](int){});
+        sig.disconnect(c);
+    }
+    signal_connection other=sig.connect([&others](int){others++;});
+    sig.disconnect(other);
+    result&=(sig.connected(keep));
+    result&=(sig.size()==1);
+    sig(1);
+    result&=(kept==1 && others==0);
+
+    sig.disconnect(keep);
+    result&=(sig.empty());
+    return result;
+};
+
+bool signal_test_main()
+{
+    bool result=true;
+    result&=signal_connect_test();
+    result&=signal_reentrancy_test();
+    result&=signal_id_wrap_test();
+    return result;
+}
@@ -0,0 +1,160 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "../../include/algorithm/simd.hpp"
+
+using namespace uboost;
+
+// compare every kernel against plain loops over lengths covering whole
+// batches and scalar tails
+template <class T>
+static bool simd_kernel_test()
+{
+    bool result=true;
+    const int maxn=70;
+    T a[maxn], b[maxn], out[maxn];
+    for(int i=0;i<maxn;i++)
+    {
+        a[i]=T((i*7)%23)-T(5);
+        b[i]=T((i*5)%11);
+    }
+
+    for(int n=0;n<=maxn;n++)
+    {
+        const T* last=a+n;
+
+        const T* f=simd::find(a, last, T(17));
+        const T* expected_f=a;
+        while(expected_f!=last && *expected_f!=T(17))expected_f++;
+        result&=(f==expected_f);
+
+        size_type c=0;
+        T s=T(), d=T();
+        for(int i=0;i<n;i++)
+        {
+            c+=(a[i]==T(3));
+            s+=a[i];
+            d+=a[i]*b[i];
+        }
+        result&=(simd::count(a, last, T(3))==c);
+        result&=(simd::sum(a, last)==s);
+        result&=(simd::dot(a, last, b)==d);
+
+        if(n)
+        {
+            T mn=a[0], mx=a[0];
+            for(int i=1;i<n;i++)
+            {
+                if(a[i]<mn)mn=a[i];
+                if(mx<a[i])mx=a[i];
+            }
+            result&=(simd::min(a, last)==mn);
+            result&=(simd::max(a, last)==mx);
+        }
+
+        simd::scale_add(a, last, T(3), b, out);
+        for(int i=0;i<n;i++)
+            result&=(out[i]==T(a[i]*T(3)+b[i]));
+
+        uint32_t mask[3]={~0u, ~0u, ~0u};
+        simd::compare_mask(a, last, T(4), simd::compare_gt, mask);
+        for(int i=0;i<n;i++)
+            result&=(((mask[i/32]>>(i%32))&1)==uint32_t(a[i]>T(4)));
+        if(n%32)
+            result&=((mask[n/32]>>(n%32))==0);
+
+        for(int i=0;i<n;i++)
+            out[i]=a[i];
+        simd::clamp(out, out+n, T(0), T(10));
+        for(int i=0;i<n;i++)
+            result&=(out[i]==((a[i]<T(0))?T(0):(a[i]>T(10))?T(10):a[i]));
+    }
+    return result;
+}
+
+template <class T>
+static bool same(T a, T b)
+{
+    return (a==b) || (a!=a && b!=b);
+}
+
+// NaN at every position must give the same result as plain loops
+template <class T>
+static bool simd_nan_test()
+{
+    bool result=true;
+    const int maxn=40;
+    const T nan=T(0)/T(0);
+    T a[maxn], out[maxn];
+    for(int n=1;n<=maxn;n++)
+    {
+        for(int p=0;p<n;p++)
+        {
+            for(int i=0;i<n;i++)
+                a[i]=T((i*7)%23)-T(5);
+            a[p]=nan;
+
+            T mn=a[0], mx=a[0];
+            for(int i=1;i<n;i++)
+            {
+                if(a[i]<mn)mn=a[i];
+                if(mx<a[i])mx=a[i];
+            }
+            result&=same(simd::min(a, a+n), mn);
+            result&=same(simd::max(a, a+n), mx);
+
+            for(int i=0;i<n;i++)
+                out[i]=a[i];
+            simd::clamp(out, out+n, T(0), T(10));
+            for(int i=0;i<n;i++)
+                result&=same(out[i], (a[i]<T(0))?T(0):(a[i]>T(10))?T(10):a[i]);
+        }
+    }
+    return result;
+}
+
+bool simd_vector_test()
+{
+    bool result=true;
+    declare::vector<float,4096>  a, b, out;
+    for(int i=0;i<4096;i++)
+    {
+        a.push_back(float(i%16));
+        b.push_back(1.0f);
+    }
+
+    result&=(simd::sum(a)==4096/16*120);
+    result&=(simd::dot(a, b)==4096/16*120);
+    result&=(simd::count(a, 3)==4096/16);
+    result&=(simd::find(a, 5)==a.cbegin()+5);
+    result&=(simd::find(a, 99)==a.cend());
+    result&=(simd::max(a)==15);
+
+    simd::scale_add(a, 2, b, out);
+    result&=(out.size()==4096);
+    result&=(out[15]==31);
+
+    simd::clamp(a, 2, 4);
+    result&=(simd::min(a)==2);
+    result&=(simd::max(a)==4);
+    return result;
+}
+
+bool simd_test_main()
+{
+    bool result=true;
+    result&=simd_kernel_test<float>();
+    result&=simd_kernel_test<double>();
+    result&=simd_kernel_test<int32_t>();
+    result&=simd_kernel_test<uint32_t>();
+    result&=simd_kernel_test<int16_t>();
+    result&=simd_kernel_test<uint8_t>();
+    // scalar fallback
+    result&=simd_kernel_test<int8_t>();
+    result&=simd_kernel_test<uint16_t>();
+    result&=simd_nan_test<float>();
+    result&=simd_nan_test<double>();
+    result&=simd_vector_test();
+    return result;
+}
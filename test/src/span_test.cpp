@@ -0,0 +1,91 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/vector.hpp"
+#include "../../include/span.hpp"
+
+using namespace uboost;
+
+static int span_sum(span<const int> s)
+{
+    int total=0;
+    for(span<const int>::iterator it=s.begin();it!=s.end();++it)
+        total+=*it;
+    return total;
+}
+
+bool span_construct_test()
+{
+    bool result=true;
+    declare::vector<int, 8> v;
+    for(int i=1;i<=5;i++)
+        v.push_back(i);
+
+    // declare::vector passed as vector or span
+    span<int> s(v);
+    result&=(s.size()==5);
+    result&=(s.data()==v.data());
+    result&=(span_sum(v)==15);
+    const uboost::vector<int>& cv=v;
+    result&=(span_sum(cv)==15);
+    result&=(make_span(cv).size()==5);
+
+    int arr[4]={1, 2, 3, 4};
+    span<int, 4> fixed(arr);
+    result&=(fixed.size()==4);
+    result&=(span_sum(fixed)==10);
+    result&=(make_span(arr).size_bytes()==sizeof(arr));
+    result&=(span<int>(arr+1, arr+3).size()==2);
+    result&=(make_span(arr, 3).back()==3);
+
+    span<int> empty;
+    result&=(empty.empty());
+    result&=(empty.begin()==empty.end());
+
+    // dynamic span is pointer and size, fixed one only pointer
+    static_assert(sizeof(span<int>)<=2*sizeof(void*), "span should be two words");
+    static_assert(sizeof(span<int, 4>)==sizeof(int*), "fixed span should be one word");
+
+    // writes go through to the viewed vector
+    s[0]=10;
+    result&=(v[0]==10);
+    return result;
+};
+
+bool span_slice_test()
+{
+    bool result=true;
+    int arr[6]={0, 1, 2, 3, 4, 5};
+    span<int> s(arr);
+
+    result&=(s.first(2).size()==2 && s.first(2).back()==1);
+    result&=(s.last(2).front()==4);
+    result&=(s.subspan(1, 3).size()==3 && s.subspan(1, 3)[2]==3);
+    result&=(s.subspan(4).size()==2 && s.subspan(4)[0]==4);
+    result&=(s.subspan(6).empty());
+
+    span<int, 6> fixed(arr);
+    span<int, 2> head=fixed.first<2>();
+    result&=(head[1]==1);
+    span<int, 3> tail=fixed.last<3>();
+    result&=(tail[0]==3);
+    span<int, 4> mid=fixed.subspan<1>().first<4>();
+    result&=(mid[3]==4);
+    span<int, 2> pair=fixed.subspan<2, 2>();
+    result&=(pair[0]==2 && pair[1]==3);
+    span<int> rest=s.subspan<3>();
+    result&=(rest.size()==3);
+
+    int expected=5;
+    for(span<int>::reverse_iterator it=s.rbegin();it!=s.rend();++it)
+        result&=(*it==expected--);
+    return result;
+};
+
+bool span_test_main()
+{
+    bool result=true;
+    result&=span_construct_test();
+    result&=span_slice_test();
+    return result;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+
+#include "../../include/uboost.hpp"
+#include "../../include/task_ring.hpp"
+
+using namespace uboost;
+
+namespace
+{
+struct owned_counter
+{
+    owned_counter(int* t, int* a):total(t),alive(a){(*alive)++;};
+    owned_counter(const owned_counter&)=delete;
+    owned_counter(owned_counter&& x):total(x.total),alive(x.alive){(*alive)++;};
+    ~owned_counter(){(*alive)--;};
+    void operator()(int v){*total+=v;};
+    int* total;
+    int* alive;
+};
+}
+
+bool task_ring_fifo_test()
+{
+    bool result=true;
+    declare::task_ring<void(int), 256> ring;
+    int order[4]={0,0,0,0};
+    int seq=0;
+
+    result&=ring.push([&order, &seq](int){order[0]=++seq;});
+    result&=ring.push([&order, &seq](int){order[1]=++seq;});
+    result&=ring.push([&order, &seq](int){order[2]=++seq;});
+    result&=(ring.size()==3);
+
+    // small capture only takes its own size plus header
+    result&=(ring.record_size<void(*)(int)>()<ring.record_size<owned_counter>()+sizeof(void*));
+
+    result&=ring.pop_invoke(0);
+    result&=(order[0]==1);
+    ring.run(0);
+    result&=(order[1]==2);
+    result&=(order[2]==3);
+    result&=(ring.empty());
+    result&=(!ring.pop_invoke(0));
+
+    return result;
+};
+
+bool task_ring_wrap_test()
+{
+    bool result=true;
+    declare::task_ring<void(int), 128> ring;
+    int total=0, alive=0;
+    int a=1, b=2, c=3;
+
+    // fill and drain repeatedly so records wrap around the ring end
+    for(int round=0;round<20;round++)
+    {
+        int pushed=0;
+        while(ring.push(owned_counter(&total, &alive)))
+        {
+            pushed++;
+            if(!ring.push([a, b, c](int v){(void)v;}))
+                break;
+            pushed++;
+        }
+        result&=(pushed>=2);
+        result&=(ring.pop_invoke(1));
+        result&=(ring.pop_invoke(1));
+    }
+    ring.clear();
+    result&=(ring.empty());
+    result&=(alive==0);
+    result&=(total>0);
+
+    return result;
+};
+
+bool task_ring_reentrant_test()
+{
+    bool result=true;
+    declare::task_ring<void(), 128> ring;
+    int calls=0;
+    struct context
+    {
+        uboost::task_ring<void()>* ring;
+        int* calls;
+    } ctx={&ring, &calls};
+
+    // task scheduling another task while it is running
+    ring.push([ctx]()
+    {
+        (*ctx.calls)++;
+        ctx.ring->push([ctx](){(*ctx.calls)+=10;});
+    });
+    ring.run();
+    result&=(calls==11);
+    result&=(ring.empty());
+
+    return result;
+};
+
+bool task_ring_test_main()
+{
+    bool result=true;
+    result&=task_ring_fifo_test();
+    result&=task_ring_wrap_test();
+    result&=task_ring_reentrant_test();
+    return result;
+}
@@ -2,10 +2,39 @@
 #include <stdlib.h>
 
 bool vector_test_main();
+bool list_test_main();
+bool function_test_main();
+bool signal_test_main();
+bool task_ring_test_main();
+bool simd_test_main();
+bool expression_test_main();
+bool io_test_main();
+void check_test_setup();
+bool check_test_main();
+bool span_test_main();
 int main()
 {
+    check_test_setup();
     if(!vector_test_main())
         std::cout<<"testing vector library failed!\r\n";
+    if(!list_test_main())
+        std::cout<<"testing list library failed!\r\n";
+    if(!function_test_main())
+        std::cout<<"testing function library failed!\r\n";
+    if(!signal_test_main())
+        std::cout<<"testing signal library failed!\r\n";
+    if(!task_ring_test_main())
+        std::cout<<"testing task_ring library failed!\r\n";
+    if(!simd_test_main())
+        std::cout<<"testing simd library failed!\r\n";
+    if(!expression_test_main())
+        std::cout<<"testing expression library failed!\r\n";
+    if(!io_test_main())
+        std::cout<<"testing io library failed!\r\n";
+    if(!check_test_main())
+        std::cout<<"testing check policy failed!\r\n";
+    if(!span_test_main())
+        std::cout<<"testing span library failed!\r\n";
 
     std::cout<<"done!\r\n";
     return 0;
@@ -116,9 +116,23 @@ bool vector_assign_test()
 
 bool vector_emplace_test()
 {
+    bool result=true;
     // basic test
+    declare::vector<int_test,10>  itv;
+    itv.emplace_back(1);
+    itv.emplace_back(3);
+    auto it=itv.emplace(itv.cbegin()+1, 2);
+    result&=(*it==2);
+    it=itv.emplace(itv.cbegin(), 0);
+    result&=(*it==0);
+    it=itv.emplace(itv.cend(), 4);
+    result&=(*it==4);
 
-    // random emplace test
+    result&=(itv.size()==5);
+    for(int i=0;i<5;i++)
+        result&=(itv[i]==i);
+
+    return result;
 }
 
 bool vector_push_pop_test()
@@ -131,21 +145,254 @@ bool vector_resize_test()
 
 bool vector_erase_test()
 {
+    bool result=true;
+    declare::vector<int_test,10>  itv;
+    for(int i=0;i<6;i++)
+        itv.emplace_back(i);
+
+    auto it=itv.erase(itv.cbegin()+1);
+    result&=(*it==2);
+    it=itv.erase(itv.cbegin()+1, itv.cbegin()+3);
+    result&=(*it==4);
+    it=itv.erase(itv.cend()-1);
+    result&=(it==itv.end());
+
+    result&=(itv.size()==2);
+    result&=(itv[0]==0);
+    result&=(itv[1]==4);
+    return result;
 }
 
 bool vector_insert_test()
 {
+    bool result=true;
+    declare::vector<uint32_t,10>  tv;
+    tv.push_back(1);
+    tv.push_back(5);
+
+    auto it=tv.insert(tv.cbegin()+1, 3, 7);
+    result&=(it==tv.begin()+1);
+    it=tv.insert(tv.cbegin(), 0);
+    result&=(*it==0);
+
+    const uint32_t expected[]={0, 1, 7, 7, 7, 5};
+    result&=(tv.size()==6);
+    for(int i=0;i<6;i++)
+        result&=(tv[i]==expected[i]);
+    return result;
+}
+
+bool vector_trivial_test()
+{
+    bool result=true;
+    static_assert(is_trivially_copyable<uint32_t>::value, "");
+    static_assert(!is_trivially_copyable<int_test>::value, "");
+    static_assert(!is_trivially_destructible<int_test>::value, "");
+
+    // bulk moves of trivially copyable elements
+    static declare::vector<uint32_t,10000>  tv;
+    tv.resize(5000, 3);
+    for(uint32_t i=0;i<5000;i++)
+        tv.insert(tv.cbegin(), i);
+    result&=(tv.size()==10000);
+    result&=(tv.front()==4999);
+    result&=(tv[4999]==0);
+    result&=(tv[5000]==3);
+
+    tv.erase(tv.cbegin(), tv.cbegin()+4998);
+    result&=(tv.size()==5002);
+    result&=(tv[0]==1);
+    result&=(tv[2]==3);
+
+    // assign from own range
+    tv.assign(tv.cbegin()+1, tv.cbegin()+4);
+    result&=(tv.size()==3);
+    result&=(tv[0]==0);
+    result&=(tv[1]==3);
+
+    declare::vector<uint8_t,10>  bv;
+    bv.resize(10, 0x5a);
+    bv.resize(4);
+    bv.resize(6, 1);
+    const uint8_t expected[]={0x5a, 0x5a, 0x5a, 0x5a, 1, 1};
+    result&=(bv.size()==6);
+    for(int i=0;i<6;i++)
+        result&=(bv[i]==expected[i]);
+    return result;
+}
+
+bool vector_size_type_test()
+{
+    bool result=true;
+    const uint32_t n=300000;
+    static declare::vector<uint32_t,n,index_type<n>::type>  tv;
+    for(uint32_t i=0;i<n;i++)
+        tv.push_back(i);
+    result&=(tv.size()==n);
+    result&=(tv.back()==n-1);
+    result&=(tv.end()-tv.begin()==(int32_t)n);
+    tv.erase(tv.cbegin(), tv.cbegin()+n-1);
+    result&=(tv.size()==1);
+    result&=(tv.front()==n-1);
+
+    declare::vector<uint32_t,10,uint8_t>  sv;
+    sv.resize(10, 1);
+    result&=(sv.size()==10);
+
+    // differences past the signed range of the index type still fit
+    declare::vector<uint32_t,200,index_type<200>::type>  nv;
+    for(uint32_t i=0;i<200;i++)
+        nv.push_back(i);
+    result&=(nv.end()-nv.begin()==200);
+    result&=(*(nv.cbegin()+150)==150);
+    result&=(nv.cend()-150==nv.cbegin()+50);
+
+    // no vtable pointer, only buffer pointer, capacity, size and storage
+    struct bare
+    {
+        uint8_t* buf;
+        uint8_t cap, sz;
+        uint8_t phys[8];
+    };
+    static_assert(sizeof(declare::vector<uint8_t,8,uint8_t>)==sizeof(bare),
+                  "vector should not carry vtable pointer");
+    return result;
+}
+
+bool vector_alignment_test()
+{
+    bool result=true;
+    declare::vector<double,3>  dv;
+    result&=((uintptr_t)dv.data()%alignof(double)==0);
+
+    struct padded
+    {
+        uint8_t before;
+        declare::vector<float,5,size_type,64> v;
+    } p;
+    result&=((uintptr_t)p.v.data()%64==0);
+    static_assert(sizeof(p.v)%64==0, "aligned vector should be padded");
+    return result;
+}
+
+// From converts implicitly to To
+template <class From, class To>
+struct converts
+{
+    static char probe(To);
+    static long probe(...);
+    static const bool value=(sizeof(probe(*static_cast<From*>(nullptr)))==sizeof(char));
+};
+
+// single-pass iterator over an array
+struct input_only_iterator
+{
+    typedef input_iterator_tag  iterator_category;
+    typedef uint32_t            value_type;
+    typedef uboost::ptrdiff_t   difference_type;
+    typedef const uint32_t*     pointer;
+    typedef const uint32_t&     reference;
+
+    explicit input_only_iterator(const uint32_t* _p):p(_p){};
+    reference operator*() const{return *p;};
+    input_only_iterator& operator++(){p++;return *this;};
+    bool operator!=(const input_only_iterator& it) const{return p!=it.p;};
+
+    const uint32_t* p;
+};
+
+bool vector_range_insert_test()
+{
+    bool result=true;
+    const uint32_t src[]={10, 11, 12};
+    declare::vector<uint32_t,20>  tv;
+    tv.push_back(0);
+    tv.push_back(1);
+
+    // contiguous source
+    auto it=tv.insert(tv.cbegin()+1, src, src+3);
+    result&=(*it==10);
+    // single-pass source
+    it=tv.insert(tv.cbegin()+1, input_only_iterator(src), input_only_iterator(src+2));
+    result&=(*it==10);
+    // bidirectional source
+    declare::listpool<uint32_t,4> pool;
+    list<uint32_t> l(pool);
+    l.push_back(20);
+    l.push_back(21);
+    tv.insert(tv.cend(), l.cbegin(), l.cend());
+
+    const uint32_t e1[]={0, 10, 11, 10, 11, 12, 1, 20, 21};
+    result&=(tv.size()==9);
+    for(int i=0;i<9;i++)
+        result&=(tv[i]==e1[i]);
+
+    tv.append(input_only_iterator(src), input_only_iterator(src+1));
+    tv.append(src+1, src+3);
+    result&=(tv.size()==12);
+    result&=(tv[9]==10);
+    result&=(tv[11]==12);
+
+    result&=(tv.erase_if([](uint32_t v){return v>=10 && v<20;})==8);
+    result&=(tv.size()==4);
+    result&=(tv[0]==0 && tv[1]==1 && tv[2]==20 && tv[3]==21);
+
+    // non trivial elements
+    declare::vector<int_test,10>  itv, itv2;
+    itv.emplace_back_n(3, 7);
+    itv2.emplace_back(1);
+    itv2.emplace_back(2);
+    typedef vector<int_test>::iterator iter_t;
+    itv.insert(itv.cbegin()+1, move_iterator<iter_t>(itv2.begin()),
+               move_iterator<iter_t>(itv2.end()));
+    result&=(itv.size()==5);
+    result&=(itv[0]==7 && itv[1]==1 && itv[2]==2 && itv[3]==7 && itv[4]==7);
+    result&=(itv.erase_if([](int_test& t){return t==7;})==3);
+    result&=(itv.size()==2);
+    result&=(itv[0]==1 && itv[1]==2);
+    return result;
 }
 
 bool vector_iterator_test()
 {
+    bool result=true;
+    declare::vector<uint32_t,10>  tv;
+    for(uint32_t i=0;i<5;i++)
+        tv.push_back(i);
+
+    uint32_t i=0;
+    for(auto it=tv.cbegin();it!=tv.cend();it++)
+        result&=(*it==i++);
+    for(auto it=tv.crbegin();it!=tv.crend();it++)
+        result&=(*it==--i);
+    result&=(tv.rbegin()[1]==3);
+    result&=(tv.cend()-tv.cbegin()==5);
+
+    // iterators are contiguous over data()
+    result&=(to_address(tv.begin())==tv.data());
+    result&=(to_address(tv.cend())==tv.data()+tv.size());
+    result&=(&tv.begin()[3]==tv.data()+3);
+    vector<uint32_t>::const_iterator cit=tv.begin()+2;
+    result&=(cit-tv.begin()==2);
+
+    // const_iterator never gives write access back
+    static_assert(converts<vector<uint32_t>::iterator, vector<uint32_t>::const_iterator>::value, "");
+    static_assert(!converts<vector<uint32_t>::const_iterator, vector<uint32_t>::iterator>::value, "");
+    return result;
 }
 
 bool vector_test_main()
 {
     bool result=true;
     result&=vector_assign_test();
+    result&=vector_emplace_test();
+    result&=vector_erase_test();
+    result&=vector_insert_test();
+    result&=vector_trivial_test();
+    result&=vector_size_type_test();
+    result&=vector_alignment_test();
+    result&=vector_range_insert_test();
     //result&=vector_stl_test();
-    //result&=vector_iterator_test();
+    result&=vector_iterator_test();
     return result;
 }